@@ -18,6 +18,7 @@ AShooterAIController::AShooterAIController(const FObjectInitializer& ObjectIniti
 	BrainComponent = BehaviorComp = ObjectInitializer.CreateDefaultSubobject<UBehaviorTreeComponent>(this, TEXT("BehaviorComp"));	
 
 	bWantsPlayerState = true;
+	bSuspended = false;
 }
 
 void AShooterAIController::OnPossess(APawn* InPawn)
@@ -45,9 +46,43 @@ void AShooterAIController::OnUnPossess()
 {
 	Super::OnUnPossess();
 
+	// a paused brain would ignore the tree started for the next pawn
+	SetSuspended(false);
 	BehaviorComp->StopTree();
 }
 
+void AShooterAIController::SetSuspended(bool bNewSuspended)
+{
+	if (bSuspended == bNewSuspended)
+	{
+		return;
+	}
+
+	static const FString SuspendReason(TEXT("Suspended"));
+	bSuspended = bNewSuspended;
+
+	// only the AI input stops, the movement mode is kept so frozen bots in the air still fall
+	if (bSuspended)
+	{
+		StopMovement();
+		BehaviorComp->PauseLogic(SuspendReason);
+
+		APawn* MyPawn = GetPawn();
+		if (MyPawn)
+		{
+			MyPawn->ConsumeMovementInputVector();
+			if (UPawnMovementComponent* MovementComp = MyPawn->GetMovementComponent())
+			{
+				MovementComp->StopMovementImmediately();
+			}
+		}
+	}
+	else
+	{
+		BehaviorComp->ResumeLogic(SuspendReason);
+	}
+}
+
 void AShooterAIController::BeginInactiveState()
 {
 	Super::BeginInactiveState();
@@ -243,6 +278,12 @@ class AShooterCharacter* AShooterAIController::GetEnemy() const
 
 void AShooterAIController::UpdateControlRotation(float DeltaTime, bool bUpdatePawn)
 {
+	// Keep facing the same way while suspended
+	if (bSuspended)
+	{
+		return;
+	}
+
 	// Look toward focus
 	FVector FocalPoint = GetFocalPoint();
 	if( !FocalPoint.IsZero() && GetPawn())
@@ -4,6 +4,7 @@
 #include "Bots/ShooterBot.h"
 #include "Bots/ShooterAIController.h"
 #include "ShooterDamageType.h"
+#include "Player/ShooterStatusEffectComponent.h"
 
 AShooterBot::AShooterBot(const FObjectInitializer& ObjectInitializer) 
 	: Super(ObjectInitializer)
@@ -32,91 +33,62 @@ void AShooterBot::DamageToBot(float DamageTaken, FDamageEvent const& DamageEvent
 	UShooterDamageType* DamageType = Cast<UShooterDamageType>(DamageEvent.DamageTypeClass->GetDefaultObject());
 	if (DamageType->bFreezeEffect && IsValid(FreezeActorClass))
 	{
-		//Freeze bot if damage is of freeze type.
-		Freeze();
+		//Freeze bot if damage is of freeze type. Ignored while another effect is active.
+		StatusEffects->ApplyEffect(EShooterStatusEffect::Freeze, FreezeTime);
 	}
 	else if (DamageType->bShrinkEffect && IsValid(ShrinkActorClass))
 	{
-		Shrink();
+		StatusEffects->ApplyEffect(EShooterStatusEffect::Shrink, ShrinkTime);
 	}
 }
 
-void AShooterBot::Freeze()
+void AShooterBot::OnStatusEffectChanged(EShooterStatusEffect::Type Effect, bool bActive)
 {
-	//If bot already has an active effect, do nothing.
-	if (bIsAnyEffectActive_Server)
+	if (GetLocalRole() == ROLE_Authority && Effect == EShooterStatusEffect::Freeze)
 	{
-		return;
+		if (bActive)
+		{
+			Freeze();
+		}
+		else
+		{
+			Unfreeze();
+		}
 	}
 
-	//Get the bot controller and unposses this pawn (stop logic).
-	BotController = GetController();
-	checkf(IsValid(BotController), TEXT("Bot has no controller, critical failure"));
-	//Stop all bot movement before we unposses it.
-	BotController->StopMovement();
-	BotController->UnPossess();
-	//Stop weapons from firing.
-	StopWeaponFire();
-
-	//Spawn the freeze actor.
-	FreezeActor = SpawnAndAttachActor(FreezeActorClass, this, FreezeTime);
-	FreezeActor->OnDestroyed.AddDynamic(this, &AShooterBot::Unfreeze);
-	//Bot currently frozen.
-	bIsAnyEffectActive_Server = true;
-}
-
-void AShooterBot::Unfreeze(AActor* DestroyedActor)
-{
-	//Reposses this pawn.
-	BotController->Possess(this);
-	//Bot no longer frozen.
-	bIsAnyEffectActive_Server = false;
+	Super::OnStatusEffectChanged(Effect, bActive);
 }
 
-bool AShooterBot::IsEnemyFor(AController* TestPC) const
+void AShooterBot::Freeze()
 {
-	//If any effect is on the bot, it might be frozen, thus unpossed.
-	//We don't want other bots to shoot during the freeze period at this pawn.
-	if (bIsAnyEffectActive_Server)
+	//Suspend the bot logic and path following, physics still applies. The controller stays possessed, so the blackboard (enemy, ammo) survives the freeze.
+	AShooterAIController* BotController = Cast<AShooterAIController>(GetController());
+	if (BotController)
 	{
-		return false;
+		BotController->SetSuspended(true);
 	}
-
-	return Super::IsEnemyFor(TestPC);
+	//Stop weapons from firing.
+	StopWeaponFire();
 }
 
-void AShooterBot::Shrink()
+void AShooterBot::Unfreeze()
 {
-	//If damanged bot already has an active effect, do nothing.
-	if (bIsAnyEffectActive_Server)
+	//Resume the bot logic. If the bot died while frozen it was already unpossessed, which clears the suspension.
+	AShooterAIController* BotController = Cast<AShooterAIController>(GetController());
+	if (BotController)
 	{
-		return;
+		BotController->SetSuspended(false);
 	}
-
-	//Spawn the shrink actor.
-	ShrinkActor = SpawnAndAttachActor(ShrinkActorClass, this, ShrinkTime);
-	ShrinkActor->OnDestroyed.AddDynamic(this, &AShooterBot::Unshrink);
-	//Call the shrink event in blueprints.
-	Server_ShrinkEvent(this, false);
-	//bot is currently shrunk. 
-	bShrunk = true;
-	bIsAnyEffectActive_Server = true;
 }
 
-void AShooterBot::Unshrink(AActor* DestroyedActor)
+bool AShooterBot::IsEnemyFor(AController* TestPC) const
 {
-	//Player is no longer shrunk, so no effects currently active.
-	bIsAnyEffectActive_Server = false;
-	bShrunk = false;
-
-	if (IsAlive())
-	{
-		//Call the shrink event in blueprints, and indicate we reverse the effect.
-		Server_ShrinkEvent(this, true);
-	}
-	else
+	//If any effect is on the bot, it might be frozen.
+	//We don't want other bots to shoot during the freeze period at this pawn.
+	if (StatusEffects->IsAnyEffectActive())
 	{
-		//Restore bot pawn size.
-		Server_RestorePawnSize(this);
+		return false;
 	}
+
+	return Super::IsEnemyFor(TestPC);
 }
@@ -0,0 +1,213 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Effects/ShooterDecalManager.h"
+#include "Components/DecalComponent.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Decals Overwritten"), STAT_ShooterDecalsOverwritten, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Decals Active"), STAT_ShooterDecalsActive, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Decal Components"), STAT_ShooterDecalComponents, STATGROUP_ShooterGame);
+
+static int32 MaxDecalsPerMaterial = 64;
+FAutoConsoleVariableRef CVarMaxDecalsPerMaterial(
+	TEXT("ShooterGame.MaxDecalsPerMaterial"),
+	MaxDecalsPerMaterial,
+	TEXT("Max number of impact / explosion decals sharing a material, new decals replace the oldest."),
+	ECVF_Default);
+
+bool UShooterDecalManager::ShouldCreateSubsystem(UObject* Outer) const
+{
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && !IsRunningDedicatedServer();
+}
+
+void UShooterDecalManager::Deinitialize()
+{
+	int32 NumComponents = 0;
+	for (const auto& It : Rings)
+	{
+		NumComponents += It.Value.Slots.Num();
+	}
+	DEC_DWORD_STAT_BY(STAT_ShooterDecalComponents, NumComponents);
+	DEC_DWORD_STAT_BY(STAT_ShooterDecalsActive, NumActive);
+
+	// components are owned by the world settings and go away with the level
+	Rings.Empty();
+	NumActive = 0;
+
+	Super::Deinitialize();
+}
+
+UDecalComponent* UShooterDecalManager::SpawnDecal(UMaterialInterface* DecalMaterial, const FVector& DecalSize, USceneComponent* AttachTo, FName BoneName, const FVector& Location, const FRotator& Rotation, float LifeSpan)
+{
+	if (DecalMaterial == nullptr)
+	{
+		return nullptr;
+	}
+
+	FShooterDecalRing& Ring = Rings.FindOrAdd(DecalMaterial);
+	const int32 Capacity = FMath::Max(1, MaxDecalsPerMaterial);
+
+	// grow until full, then go around
+	FShooterDecalSlot* Slot = nullptr;
+	if (Ring.Slots.Num() < Capacity && Ring.Next >= Ring.Slots.Num())
+	{
+		UDecalComponent* NewDecal = CreateDecal(DecalMaterial);
+		if (NewDecal == nullptr)
+		{
+			return nullptr;
+		}
+		Slot = &Ring.Slots.AddDefaulted_GetRef();
+		Slot->Decal = NewDecal;
+	}
+	else
+	{
+		Ring.Next = Ring.Next % Ring.Slots.Num();
+		Slot = &Ring.Slots[Ring.Next];
+		if (Slot->bActive)
+		{
+			NumOverwritten++;
+			INC_DWORD_STAT(STAT_ShooterDecalsOverwritten);
+			DeactivateSlot(*Slot);
+		}
+
+		if (!IsValid(Slot->Decal))
+		{
+			DEC_DWORD_STAT(STAT_ShooterDecalComponents);
+			Slot->Decal = CreateDecal(DecalMaterial);
+			if (Slot->Decal == nullptr)
+			{
+				return nullptr;
+			}
+		}
+	}
+	Ring.Next++;
+
+	UDecalComponent* Decal = Slot->Decal;
+	if (Decal->DecalSize != DecalSize)
+	{
+		Decal->DecalSize = DecalSize;
+		Decal->MarkRenderStateDirty();
+	}
+
+	if (AttachTo)
+	{
+		Decal->AttachToComponent(AttachTo, FAttachmentTransformRules::KeepWorldTransform, BoneName);
+	}
+	Decal->SetWorldLocationAndRotation(Location, Rotation);
+	Decal->SetVisibility(true);
+
+	Slot->AttachTarget = AttachTo;
+	Slot->bAttached = AttachTo != nullptr;
+	Slot->ExpireTime = LifeSpan > 0.0f ? GetWorld()->GetTimeSeconds() + LifeSpan : 0.0f;
+	Slot->bActive = true;
+
+	NumActive++;
+	INC_DWORD_STAT(STAT_ShooterDecalsActive);
+	return Decal;
+}
+
+void UShooterDecalManager::Tick(float DeltaTime)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	for (auto& It : Rings)
+	{
+		for (FShooterDecalSlot& Slot : It.Value.Slots)
+		{
+			if (!Slot.bActive)
+			{
+				continue;
+			}
+
+			bool bRemove = !IsValid(Slot.Decal) || (Slot.ExpireTime > 0.0f && Now >= Slot.ExpireTime);
+
+			// don't leave decals floating where a destroyed or ragdolling mesh used to be
+			if (!bRemove && Slot.bAttached)
+			{
+				USceneComponent* Target = Slot.AttachTarget.Get();
+				UPrimitiveComponent* TargetPrimitive = Cast<UPrimitiveComponent>(Target);
+				if (Target == nullptr || Target->IsBeingDestroyed() || (TargetPrimitive && TargetPrimitive->IsSimulatingPhysics()))
+				{
+					NumCleanedUp++;
+					bRemove = true;
+				}
+			}
+
+			if (bRemove)
+			{
+				DeactivateSlot(Slot);
+			}
+		}
+	}
+}
+
+bool UShooterDecalManager::IsTickable() const
+{
+	return NumActive > 0 && !IsTemplate();
+}
+
+TStatId UShooterDecalManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterDecalManager, STATGROUP_Tickables);
+}
+
+UWorld* UShooterDecalManager::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterDecalManager::DumpStats() const
+{
+	UE_LOG(LogShooter, Log, TEXT("Decal manager: %d active, %d overwritten, %d cleaned up (max %d per material)"), NumActive, NumOverwritten, NumCleanedUp, MaxDecalsPerMaterial);
+	for (const auto& It : Rings)
+	{
+		UE_LOG(LogShooter, Log, TEXT("  %s: %d components"), *GetNameSafe(It.Key), It.Value.Slots.Num());
+	}
+}
+
+UDecalComponent* UShooterDecalManager::CreateDecal(UMaterialInterface* DecalMaterial)
+{
+	UWorld* World = GetWorld();
+	AWorldSettings* WorldSettings = World ? World->GetWorldSettings() : nullptr;
+	if (WorldSettings == nullptr)
+	{
+		return nullptr;
+	}
+
+	UDecalComponent* Decal = NewObject<UDecalComponent>(WorldSettings);
+	Decal->SetDecalMaterial(DecalMaterial);
+	Decal->SetVisibility(false);
+	Decal->RegisterComponentWithWorld(World);
+
+	INC_DWORD_STAT(STAT_ShooterDecalComponents);
+	return Decal;
+}
+
+void UShooterDecalManager::DeactivateSlot(FShooterDecalSlot& Slot)
+{
+	if (IsValid(Slot.Decal))
+	{
+		Slot.Decal->SetVisibility(false);
+		if (Slot.Decal->GetAttachParent())
+		{
+			Slot.Decal->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+		}
+	}
+
+	Slot.AttachTarget.Reset();
+	Slot.bAttached = false;
+	Slot.bActive = false;
+
+	NumActive--;
+	DEC_DWORD_STAT(STAT_ShooterDecalsActive);
+}
+
+FAutoConsoleCommandWithWorld ShooterDumpDecalsCmd(TEXT("ShooterGame.DumpDecals"), TEXT("Prints impact / explosion decal ring usage"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UShooterDecalManager* DecalManager = World ? World->GetSubsystem<UShooterDecalManager>() : nullptr)
+		{
+			DecalManager->DumpStats();
+		}
+	})
+);
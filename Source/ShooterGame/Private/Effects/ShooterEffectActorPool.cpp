@@ -0,0 +1,178 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Effects/ShooterEffectActorPool.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Effect Actor Pool Hits"), STAT_ShooterEffectPoolHits, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Effect Actor Pool Misses"), STAT_ShooterEffectPoolMisses, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Effect Actors Active"), STAT_ShooterEffectPoolActive, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Effect Actors Pooled"), STAT_ShooterEffectPoolSize, STATGROUP_ShooterGame);
+
+bool UShooterEffectActorPool::ShouldCreateSubsystem(UObject* Outer) const
+{
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UShooterEffectActorPool::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_ShooterEffectPoolActive, ActiveActors.Num());
+	DEC_DWORD_STAT_BY(STAT_ShooterEffectPoolSize, NumGrowth);
+
+	// actors are owned by the level and go away with it
+	FreeActors.Empty();
+	ActiveActors.Empty();
+
+	Super::Deinitialize();
+}
+
+void UShooterEffectActorPool::Prewarm(TSubclassOf<AActor> ActorClass, int32 Count)
+{
+	if (ActorClass == nullptr)
+	{
+		return;
+	}
+
+	TArray<AActor*>& Pool = FreeActors.FindOrAdd(ActorClass).Actors;
+	while (Pool.Num() < Count)
+	{
+		AActor* NewActor = SpawnPooledActor(ActorClass);
+		if (NewActor == nullptr)
+		{
+			break;
+		}
+		Pool.Add(NewActor);
+	}
+}
+
+AActor* UShooterEffectActorPool::AcquireAttached(TSubclassOf<AActor> ActorClass, AActor* Target, float LifeSpan, FOnPooledEffectReleased OnReleased)
+{
+	if (ActorClass == nullptr || Target == nullptr)
+	{
+		return nullptr;
+	}
+
+	AActor* EffectActor = nullptr;
+	TArray<AActor*>& Pool = FreeActors.FindOrAdd(ActorClass).Actors;
+	while (Pool.Num() > 0 && EffectActor == nullptr)
+	{
+		AActor* Candidate = Pool.Pop(false);
+		if (IsValid(Candidate))
+		{
+			EffectActor = Candidate;
+		}
+	}
+
+	if (EffectActor)
+	{
+		NumHits++;
+		INC_DWORD_STAT(STAT_ShooterEffectPoolHits);
+	}
+	else
+	{
+		NumMisses++;
+		INC_DWORD_STAT(STAT_ShooterEffectPoolMisses);
+
+		EffectActor = SpawnPooledActor(ActorClass);
+		if (EffectActor == nullptr)
+		{
+			return nullptr;
+		}
+	}
+
+	// place over the target and attach
+	EffectActor->SetActorLocation(Target->GetActorLocation());
+	EffectActor->AttachToActor(Target, FAttachmentTransformRules::KeepWorldTransform);
+	SetPooledActorActive(EffectActor, true);
+
+	FActiveEffectActor& ActiveInfo = ActiveActors.Add(EffectActor);
+	ActiveInfo.Target = Target;
+	ActiveInfo.OnReleased = OnReleased;
+	if (LifeSpan > 0.0f)
+	{
+		FTimerDelegate ReleaseDelegate = FTimerDelegate::CreateUObject(this, &UShooterEffectActorPool::Release, EffectActor);
+		GetWorld()->GetTimerManager().SetTimer(ActiveInfo.TimerHandle_Release, ReleaseDelegate, LifeSpan, false);
+	}
+
+	INC_DWORD_STAT(STAT_ShooterEffectPoolActive);
+	return EffectActor;
+}
+
+void UShooterEffectActorPool::Release(AActor* EffectActor)
+{
+	FActiveEffectActor ActiveInfo;
+	if (EffectActor == nullptr || !ActiveActors.RemoveAndCopyValue(EffectActor, ActiveInfo))
+	{
+		return;
+	}
+
+	DEC_DWORD_STAT(STAT_ShooterEffectPoolActive);
+	GetWorld()->GetTimerManager().ClearTimer(ActiveInfo.TimerHandle_Release);
+
+	if (IsValid(EffectActor))
+	{
+		EffectActor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+		SetPooledActorActive(EffectActor, false);
+		FreeActors.FindOrAdd(EffectActor->GetClass()).Actors.Add(EffectActor);
+	}
+
+	// notify last, the callback may acquire again
+	ActiveInfo.OnReleased.ExecuteIfBound(ActiveInfo.Target.Get());
+}
+
+void UShooterEffectActorPool::ReleaseAllAttachedTo(AActor* Target)
+{
+	TArray<AActor*> ToRelease;
+	for (const auto& It : ActiveActors)
+	{
+		if (It.Value.Target.Get() == Target)
+		{
+			ToRelease.Add(It.Key.Get());
+		}
+	}
+
+	for (AActor* EffectActor : ToRelease)
+	{
+		Release(EffectActor);
+	}
+}
+
+void UShooterEffectActorPool::DumpStats() const
+{
+	UE_LOG(LogShooter, Log, TEXT("Effect actor pool: %d hits, %d misses, %d spawned, %d active"), NumHits, NumMisses, NumGrowth, ActiveActors.Num());
+	for (const auto& It : FreeActors)
+	{
+		UE_LOG(LogShooter, Log, TEXT("  %s: %d idle"), *GetNameSafe(It.Key), It.Value.Actors.Num());
+	}
+}
+
+AActor* UShooterEffectActorPool::SpawnPooledActor(UClass* ActorClass)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AActor* NewActor = GetWorld()->SpawnActor<AActor>(ActorClass, FTransform::Identity, SpawnParameters);
+	if (NewActor)
+	{
+		SetPooledActorActive(NewActor, false);
+		NumGrowth++;
+		INC_DWORD_STAT(STAT_ShooterEffectPoolSize);
+	}
+	return NewActor;
+}
+
+void UShooterEffectActorPool::SetPooledActorActive(AActor* EffectActor, bool bActive)
+{
+	EffectActor->SetActorHiddenInGame(!bActive);
+	EffectActor->SetActorEnableCollision(bActive);
+	EffectActor->SetActorTickEnabled(bActive);
+}
+
+FAutoConsoleCommandWithWorld ShooterDumpEffectPoolCmd(TEXT("ShooterGame.DumpEffectActorPool"), TEXT("Prints status effect actor pool hits, misses and growth"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UShooterEffectActorPool* Pool = World ? World->GetSubsystem<UShooterEffectActorPool>() : nullptr)
+		{
+			Pool->DumpStats();
+		}
+	})
+);
@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "ShooterExplosionEffect.h"
+#include "Effects/ShooterDecalManager.h"
 
 AShooterExplosionEffect::AShooterExplosionEffect(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -40,10 +41,20 @@ void AShooterExplosionEffect::BeginPlay()
 		FRotator RandomDecalRotation = SurfaceHit.ImpactNormal.Rotation();
 		RandomDecalRotation.Roll = FMath::FRandRange(-180.0f, 180.0f);
 
-		UGameplayStatics::SpawnDecalAttached(Decal.DecalMaterial, FVector(Decal.DecalSize, Decal.DecalSize, 1.0f),
-			SurfaceHit.Component.Get(), SurfaceHit.BoneName,
-			SurfaceHit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition,
-			Decal.LifeSpan);
+		// bounded ring of decals per material
+		if (UShooterDecalManager* DecalManager = GetWorld()->GetSubsystem<UShooterDecalManager>())
+		{
+			DecalManager->SpawnDecal(Decal.DecalMaterial, FVector(Decal.DecalSize, Decal.DecalSize, 1.0f),
+				SurfaceHit.Component.Get(), SurfaceHit.BoneName,
+				SurfaceHit.ImpactPoint, RandomDecalRotation, Decal.LifeSpan);
+		}
+		else
+		{
+			UGameplayStatics::SpawnDecalAttached(Decal.DecalMaterial, FVector(Decal.DecalSize, Decal.DecalSize, 1.0f),
+				SurfaceHit.Component.Get(), SurfaceHit.BoneName,
+				SurfaceHit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition,
+				Decal.LifeSpan);
+		}
 	}
 }
 
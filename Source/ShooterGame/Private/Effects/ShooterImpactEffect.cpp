@@ -2,31 +2,71 @@
 
 #include "ShooterGame.h"
 #include "ShooterImpactEffect.h"
+#include "Effects/ShooterDecalManager.h"
 
 AShooterImpactEffect::AShooterImpactEffect(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
+	ParticleComp = ObjectInitializer.CreateDefaultSubobject<UParticleSystemComponent>(this, TEXT("ParticleComp"));
+	ParticleComp->bAutoActivate = false;
+	ParticleComp->bAutoDestroy = false;
+	RootComponent = ParticleComp;
+
+	AudioComp = ObjectInitializer.CreateDefaultSubobject<UAudioComponent>(this, TEXT("AudioComp"));
+	AudioComp->bAutoActivate = false;
+	AudioComp->bAutoDestroy = false;
+	AudioComp->SetupAttachment(RootComponent);
+
 	SetAutoDestroyWhenFinished(true);
+	SurfaceTypeOverride = SurfaceType_Max;
+	bPooled = false;
+	bParticlesPlaying = false;
+	bSoundPlaying = false;
+	LastPlayTime = 0.0f;
 }
 
 void AShooterImpactEffect::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
+	ParticleComp->OnSystemFinished.AddDynamic(this, &AShooterImpactEffect::OnParticlesFinished);
+	AudioComp->OnAudioFinished.AddDynamic(this, &AShooterImpactEffect::OnSoundFinished);
+
+	// pooled actors are played by the pool
+	if (!bPooled)
+	{
+		PlayEffect();
+	}
+}
+
+void AShooterImpactEffect::PlayEffect()
+{
 	UPhysicalMaterial* HitPhysMat = SurfaceHit.PhysMaterial.Get();
-	EPhysicalSurface HitSurfaceType = UPhysicalMaterial::DetermineSurfaceType(HitPhysMat);
+	EPhysicalSurface HitSurfaceType = SurfaceTypeOverride != SurfaceType_Max ? SurfaceTypeOverride.GetValue() : UPhysicalMaterial::DetermineSurfaceType(HitPhysMat);
+
+	LastPlayTime = GetWorld()->GetTimeSeconds();
 
 	// show particles
 	UParticleSystem* ImpactFX = GetImpactFX(HitSurfaceType);
+	bParticlesPlaying = ImpactFX != nullptr;
 	if (ImpactFX)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(this, ImpactFX, GetActorLocation(), GetActorRotation());
+		if (ParticleComp->Template != ImpactFX)
+		{
+			ParticleComp->SetTemplate(ImpactFX);
+		}
+		ParticleComp->ActivateSystem(true);
 	}
 
 	// play sound
 	USoundCue* ImpactSound = GetImpactSound(HitSurfaceType);
+	bSoundPlaying = ImpactSound != nullptr;
 	if (ImpactSound)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation());
+		if (AudioComp->Sound != ImpactSound)
+		{
+			AudioComp->SetSound(ImpactSound);
+		}
+		AudioComp->Play();
 	}
 
 	if (DefaultDecal.DecalMaterial)
@@ -34,11 +74,51 @@ void AShooterImpactEffect::PostInitializeComponents()
 		FRotator RandomDecalRotation = SurfaceHit.ImpactNormal.Rotation();
 		RandomDecalRotation.Roll = FMath::FRandRange(-180.0f, 180.0f);
 
-		UGameplayStatics::SpawnDecalAttached(DefaultDecal.DecalMaterial, FVector(1.0f, DefaultDecal.DecalSize, DefaultDecal.DecalSize),
-			SurfaceHit.Component.Get(), SurfaceHit.BoneName,
-			SurfaceHit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition,
-			DefaultDecal.LifeSpan);
+		// bounded ring of decals per material
+		if (UShooterDecalManager* DecalManager = GetWorld()->GetSubsystem<UShooterDecalManager>())
+		{
+			DecalManager->SpawnDecal(DefaultDecal.DecalMaterial, FVector(1.0f, DefaultDecal.DecalSize, DefaultDecal.DecalSize),
+				SurfaceHit.Component.Get(), SurfaceHit.BoneName,
+				SurfaceHit.ImpactPoint, RandomDecalRotation, DefaultDecal.LifeSpan);
+		}
+		else if (SurfaceHit.Component.IsValid())
+		{
+			UGameplayStatics::SpawnDecalAttached(DefaultDecal.DecalMaterial, FVector(1.0f, DefaultDecal.DecalSize, DefaultDecal.DecalSize),
+				SurfaceHit.Component.Get(), SurfaceHit.BoneName,
+				SurfaceHit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition,
+				DefaultDecal.LifeSpan);
+		}
+		else
+		{
+			// replicated impacts don't know the component
+			UGameplayStatics::SpawnDecalAtLocation(this, DefaultDecal.DecalMaterial, FVector(1.0f, DefaultDecal.DecalSize, DefaultDecal.DecalSize),
+				SurfaceHit.ImpactPoint, RandomDecalRotation, DefaultDecal.LifeSpan);
+		}
+	}
+}
+
+void AShooterImpactEffect::StopEffect()
+{
+	if (bParticlesPlaying)
+	{
+		ParticleComp->DeactivateImmediate();
+		bParticlesPlaying = false;
 	}
+	if (bSoundPlaying)
+	{
+		AudioComp->Stop();
+		bSoundPlaying = false;
+	}
+}
+
+void AShooterImpactEffect::OnParticlesFinished(UParticleSystemComponent* FinishedComponent)
+{
+	bParticlesPlaying = false;
+}
+
+void AShooterImpactEffect::OnSoundFinished()
+{
+	bSoundPlaying = false;
 }
 
 UParticleSystem* AShooterImpactEffect::GetImpactFX(TEnumAsByte<EPhysicalSurface> SurfaceType) const
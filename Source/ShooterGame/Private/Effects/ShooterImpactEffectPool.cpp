@@ -0,0 +1,224 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Effects/ShooterImpactEffectPool.h"
+#include "Effects/ShooterImpactEffect.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impact Effects Dropped (budget)"), STAT_ShooterImpactEffectsDroppedBudget, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impact Effects Dropped (distance)"), STAT_ShooterImpactEffectsDroppedDistance, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Impact Effects Active"), STAT_ShooterImpactEffectsActive, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Impact Effects Pooled"), STAT_ShooterImpactEffectsPooled, STATGROUP_ShooterGame);
+
+static int32 ImpactEffectsPerFrame = 8;
+FAutoConsoleVariableRef CVarImpactEffectsPerFrame(
+	TEXT("ShooterGame.ImpactEffectsPerFrame"),
+	ImpactEffectsPerFrame,
+	TEXT("Max number of weapon impact effects started in one frame, the rest are dropped."),
+	ECVF_Default);
+
+static int32 MaxImpactEffects = 48;
+FAutoConsoleVariableRef CVarMaxImpactEffects(
+	TEXT("ShooterGame.MaxImpactEffects"),
+	MaxImpactEffects,
+	TEXT("Max number of weapon impact effects playing at once, new ones are dropped."),
+	ECVF_Default);
+
+static float ImpactEffectCullDistance = 8000.0f;
+FAutoConsoleVariableRef CVarImpactEffectCullDistance(
+	TEXT("ShooterGame.ImpactEffectCullDistance"),
+	ImpactEffectCullDistance,
+	TEXT("Weapon impact effects farther than this from every local viewer are dropped, 0 to disable."),
+	ECVF_Default);
+
+const float UShooterImpactEffectPool::MaxEffectLifeSpan = 10.0f;
+
+bool UShooterImpactEffectPool::ShouldCreateSubsystem(UObject* Outer) const
+{
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && !IsRunningDedicatedServer();
+}
+
+void UShooterImpactEffectPool::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_ShooterImpactEffectsActive, ActiveEffects.Num());
+	DEC_DWORD_STAT_BY(STAT_ShooterImpactEffectsPooled, PooledEffects.Num());
+
+	// actors are owned by the level and go away with it
+	PooledEffects.Empty();
+	ActiveEffects.Empty();
+	FreeEffects.Empty();
+
+	Super::Deinitialize();
+}
+
+AShooterImpactEffect* UShooterImpactEffectPool::SpawnEffect(TSubclassOf<AShooterImpactEffect> EffectClass, const FHitResult& Impact, EPhysicalSurface SurfaceType)
+{
+	if (EffectClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (SpawnFrame != GFrameCounter)
+	{
+		SpawnFrame = GFrameCounter;
+		NumSpawnedThisFrame = 0;
+	}
+
+	if (NumSpawnedThisFrame >= ImpactEffectsPerFrame || ActiveEffects.Num() >= MaxImpactEffects)
+	{
+		NumDroppedBudget++;
+		INC_DWORD_STAT(STAT_ShooterImpactEffectsDroppedBudget);
+		return nullptr;
+	}
+
+	if (!IsInCullDistance(Impact.ImpactPoint))
+	{
+		NumDroppedDistance++;
+		INC_DWORD_STAT(STAT_ShooterImpactEffectsDroppedDistance);
+		return nullptr;
+	}
+
+	const EPhysicalSurface HitSurfaceType = SurfaceType != SurfaceType_Max ? SurfaceType : UPhysicalMaterial::DetermineSurfaceType(Impact.PhysMaterial.Get());
+	const FTransform SpawnTransform(Impact.ImpactNormal.Rotation(), Impact.ImpactPoint);
+
+	AShooterImpactEffect* Effect = nullptr;
+	TArray<AShooterImpactEffect*>& FreeList = FreeEffects.FindOrAdd(FEffectKey(EffectClass, (uint8)HitSurfaceType));
+	while (FreeList.Num() > 0 && Effect == nullptr)
+	{
+		AShooterImpactEffect* Candidate = FreeList.Pop(false);
+		if (IsValid(Candidate))
+		{
+			Effect = Candidate;
+		}
+	}
+
+	if (Effect)
+	{
+		NumHits++;
+		Effect->SetActorTransform(SpawnTransform);
+		Effect->SetActorHiddenInGame(false);
+	}
+	else
+	{
+		NumMisses++;
+
+		Effect = GetWorld()->SpawnActorDeferred<AShooterImpactEffect>(EffectClass, SpawnTransform);
+		if (Effect == nullptr)
+		{
+			return nullptr;
+		}
+		Effect->bPooled = true;
+		Effect->SetAutoDestroyWhenFinished(false);
+		UGameplayStatics::FinishSpawningActor(Effect, SpawnTransform);
+
+		PooledEffects.Add(Effect);
+		INC_DWORD_STAT(STAT_ShooterImpactEffectsPooled);
+	}
+
+	Effect->SurfaceHit = Impact;
+	Effect->SurfaceTypeOverride = HitSurfaceType;
+	Effect->PlayEffect();
+
+	NumSpawnedThisFrame++;
+	ActiveEffects.Add(Effect);
+	INC_DWORD_STAT(STAT_ShooterImpactEffectsActive);
+	return Effect;
+}
+
+void UShooterImpactEffectPool::Tick(float DeltaTime)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	for (int32 EffectIdx = ActiveEffects.Num() - 1; EffectIdx >= 0; EffectIdx--)
+	{
+		AShooterImpactEffect* Effect = ActiveEffects[EffectIdx];
+		if (!IsValid(Effect))
+		{
+			ActiveEffects.RemoveAtSwap(EffectIdx, 1, false);
+			DEC_DWORD_STAT(STAT_ShooterImpactEffectsActive);
+			continue;
+		}
+
+		// don't let a looping template hold the actor forever
+		if (Effect->IsEffectPlaying() && Now - Effect->GetLastPlayTime() > MaxEffectLifeSpan)
+		{
+			Effect->StopEffect();
+		}
+
+		if (!Effect->IsEffectPlaying())
+		{
+			ActiveEffects.RemoveAtSwap(EffectIdx, 1, false);
+			DEC_DWORD_STAT(STAT_ShooterImpactEffectsActive);
+			ReturnToPool(Effect);
+		}
+	}
+}
+
+bool UShooterImpactEffectPool::IsTickable() const
+{
+	return ActiveEffects.Num() > 0 && !IsTemplate();
+}
+
+TStatId UShooterImpactEffectPool::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterImpactEffectPool, STATGROUP_Tickables);
+}
+
+UWorld* UShooterImpactEffectPool::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterImpactEffectPool::DumpStats() const
+{
+	UE_LOG(LogShooter, Log, TEXT("Impact effect pool: %d active of %d pooled (budget %d, %d per frame)"), ActiveEffects.Num(), PooledEffects.Num(), MaxImpactEffects, ImpactEffectsPerFrame);
+	UE_LOG(LogShooter, Log, TEXT("  %d hits, %d misses, %d dropped over budget, %d dropped by distance"), NumHits, NumMisses, NumDroppedBudget, NumDroppedDistance);
+	for (const auto& It : FreeEffects)
+	{
+		const UEnum* SurfaceEnum = StaticEnum<EPhysicalSurface>();
+		UE_LOG(LogShooter, Log, TEXT("  %s %s: %d idle"), *GetNameSafe(It.Key.Key), SurfaceEnum ? *SurfaceEnum->GetNameStringByValue(It.Key.Value) : TEXT(""), It.Value.Num());
+	}
+}
+
+bool UShooterImpactEffectPool::IsInCullDistance(const FVector& Location) const
+{
+	if (ImpactEffectCullDistance <= 0.0f)
+	{
+		return true;
+	}
+
+	bool bHasViewer = false;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		if (PC && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			if (FVector::DistSquared(ViewLocation, Location) <= FMath::Square(ImpactEffectCullDistance))
+			{
+				return true;
+			}
+			bHasViewer = true;
+		}
+	}
+
+	// nobody to cull for
+	return !bHasViewer;
+}
+
+void UShooterImpactEffectPool::ReturnToPool(AShooterImpactEffect* Effect)
+{
+	Effect->SetActorHiddenInGame(true);
+	FreeEffects.FindOrAdd(FEffectKey(Effect->GetClass(), (uint8)Effect->SurfaceTypeOverride.GetValue())).Add(Effect);
+}
+
+FAutoConsoleCommandWithWorld ShooterDumpImpactEffectPoolCmd(TEXT("ShooterGame.DumpImpactEffectPool"), TEXT("Prints weapon impact effect pool occupancy and dropped effects"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UShooterImpactEffectPool* Pool = World ? World->GetSubsystem<UShooterImpactEffectPool>() : nullptr)
+		{
+			Pool->DumpStats();
+		}
+	})
+);
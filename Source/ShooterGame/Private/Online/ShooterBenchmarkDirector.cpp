@@ -0,0 +1,298 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterBenchmarkDirector.h"
+#include "Bots/ShooterAIController.h"
+#include "Weapons/ShooterWeapon.h"
+#include "Weapons/ShooterDamageType.h"
+#include "Online/ShooterPlayerState.h"
+#include "HAL/FileManager.h"
+
+AShooterBenchmarkDirector::AShooterBenchmarkDirector(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	// bot pawns only carry the gun and the rocket launcher
+	static ConstructorHelpers::FClassFinder<AShooterWeapon> FreezeWeaponOb(TEXT("/Game/Blueprints/Weapons/WeapLauncher_Freeze"));
+	FreezeWeaponClass = FreezeWeaponOb.Class;
+
+	static ConstructorHelpers::FClassFinder<AShooterWeapon> ShrinkWeaponOb(TEXT("/Game/Blueprints/Weapons/WeapLauncher_Shrink"));
+	ShrinkWeaponClass = ShrinkWeaponOb.Class;
+
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
+	SetReplicates(false);
+
+	CsvFile = nullptr;
+	EndTime = 0.0f;
+	FrameSpawns = 0;
+	FrameGCSeconds = 0.0;
+	GCStartTime = 0.0;
+	NumFrames = 0;
+	TotalFrameSeconds = 0.0;
+	MaxFrameSeconds = 0.0;
+	TotalSpawns = 0;
+	TotalGCSeconds = 0.0;
+	TotalOutBytes = 0;
+	ArmedBots = 0;
+	SkippedBots = 0;
+	MaxSkippedBots = 0;
+	bMeasuredOutBytes = false;
+}
+
+void AShooterBenchmarkDirector::StartBenchmark(int32 Duration)
+{
+	const FString CsvPath = FPaths::ProfilingDir() / TEXT("ShooterBenchmark") / FString::Printf(TEXT("StatusEffects-%s.csv"), *FDateTime::Now().ToString());
+	CsvFile = IFileManager::Get().CreateFileWriter(*CsvPath);
+	if (CsvFile == nullptr)
+	{
+		UE_LOG(LogShooter, Error, TEXT("Benchmark: can't write %s"), *CsvPath);
+		return;
+	}
+
+	const FString Header = TEXT("Frame,Time,FrameMs,GameThreadMs,Spawns,GCMs,Connections,OutBytes,MaxConnectionOutBytes,ArmedBots,SkippedBots\n");
+	CsvFile->Serialize(TCHAR_TO_ANSI(*Header), Header.Len());
+
+	UWorld* World = GetWorld();
+	OnActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &AShooterBenchmarkDirector::OnActorSpawned));
+	OnPreGarbageCollectHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &AShooterBenchmarkDirector::OnPreGarbageCollect);
+	OnPostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &AShooterBenchmarkDirector::OnPostGarbageCollect);
+
+	EndTime = World->GetTimeSeconds() + Duration;
+	GetWorldTimerManager().SetTimer(TimerHandle_UpdateBots, this, &AShooterBenchmarkDirector::UpdateBots, 1.0f, true, 0.0f);
+	SetActorTickEnabled(true);
+
+	UE_LOG(LogShooter, Log, TEXT("Benchmark: recording %d seconds to %s"), Duration, *CsvPath);
+}
+
+void AShooterBenchmarkDirector::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (CsvFile == nullptr)
+	{
+		return;
+	}
+
+	RecordFrame(DeltaSeconds);
+
+	if (GetWorld()->GetTimeSeconds() >= EndTime)
+	{
+		FinishBenchmark();
+	}
+}
+
+void AShooterBenchmarkDirector::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopRecording();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AShooterBenchmarkDirector::UpdateBots()
+{
+	int32 BotIdx = 0;
+	ArmedBots = 0;
+	SkippedBots = 0;
+	for (AShooterAIController* Bot : TActorRange<AShooterAIController>(GetWorld()))
+	{
+		AShooterCharacter* BotPawn = Cast<AShooterCharacter>(Bot->GetPawn());
+		if (BotPawn == nullptr || !BotPawn->IsAlive())
+		{
+			continue;
+		}
+
+		// alternate freeze and shrink between bots, so both code paths run every frame
+		const bool bWantsFreeze = (BotIdx++ & 1) == 0;
+		AShooterWeapon* EffectWeapon = GiveEffectWeapon(BotPawn, bWantsFreeze);
+		if (EffectWeapon == nullptr)
+		{
+			SkippedBots++;
+			continue;
+		}
+		ArmedBots++;
+
+		if (BotPawn->GetWeapon() != EffectWeapon)
+		{
+			BotPawn->EquipWeapon(EffectWeapon);
+		}
+
+		if (EffectWeapon->GetCurrentAmmo() < EffectWeapon->GetMaxAmmo() / 2)
+		{
+			EffectWeapon->GiveAmmo(EffectWeapon->GetMaxAmmo());
+		}
+
+		// bots with an active effect aren't enemies (AShooterBot::IsEnemyFor), so once half of them are hit the others
+		// find nobody to shoot. Hand out targets directly, ShootEnemy fires at them whenever they are in sight.
+		AShooterCharacter* Enemy = Bot->GetEnemy();
+		if (Enemy == nullptr || !Enemy->IsAlive())
+		{
+			if (AShooterCharacter* Target = FindTarget(BotPawn))
+			{
+				Bot->SetEnemy(Target);
+			}
+		}
+	}
+
+	if (SkippedBots > MaxSkippedBots)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Benchmark: %d of %d bots couldn't be given a freeze or shrink weapon and don't add load"), SkippedBots, ArmedBots + SkippedBots);
+		MaxSkippedBots = SkippedBots;
+	}
+}
+
+AShooterWeapon* AShooterBenchmarkDirector::GiveEffectWeapon(AShooterCharacter* BotPawn, bool bWantsFreeze)
+{
+	for (int32 WeaponIdx = 0; WeaponIdx < BotPawn->GetInventoryCount(); WeaponIdx++)
+	{
+		AShooterWeapon* Weapon = BotPawn->GetInventoryWeapon(WeaponIdx);
+		const TSubclassOf<UDamageType> DamageTypeClass = Weapon ? Weapon->GetDamageType() : nullptr;
+		const UShooterDamageType* DamageType = DamageTypeClass ? Cast<UShooterDamageType>(DamageTypeClass->GetDefaultObject()) : nullptr;
+		if (DamageType && (bWantsFreeze ? DamageType->bFreezeEffect : DamageType->bShrinkEffect))
+		{
+			return Weapon;
+		}
+	}
+
+	TSubclassOf<AShooterWeapon> WeaponClass = bWantsFreeze ? FreezeWeaponClass : ShrinkWeaponClass;
+	if (WeaponClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	// the bot's player state keeps the launcher of its last life
+	AShooterPlayerState* BotPlayerState = BotPawn->GetPlayerState<AShooterPlayerState>();
+	AShooterWeapon* NewWeapon = BotPlayerState ? BotPlayerState->TakeStoredWeapon(WeaponClass) : nullptr;
+	if (NewWeapon == nullptr)
+	{
+		FActorSpawnParameters SpawnInfo;
+		SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		NewWeapon = GetWorld()->SpawnActor<AShooterWeapon>(WeaponClass, SpawnInfo);
+	}
+
+	BotPawn->AddWeapon(NewWeapon);
+	return NewWeapon;
+}
+
+AShooterCharacter* AShooterBenchmarkDirector::FindTarget(const AShooterCharacter* BotPawn) const
+{
+	const FVector BotLocation = BotPawn->GetActorLocation();
+	float BestDistSq = MAX_FLT;
+	AShooterCharacter* BestTarget = nullptr;
+
+	for (AShooterAIController* Bot : TActorRange<AShooterAIController>(GetWorld()))
+	{
+		AShooterCharacter* TestPawn = Cast<AShooterCharacter>(Bot->GetPawn());
+		if (TestPawn && TestPawn != BotPawn && TestPawn->IsAlive())
+		{
+			const float DistSq = FVector::DistSquared(TestPawn->GetActorLocation(), BotLocation);
+			if (DistSq < BestDistSq)
+			{
+				BestDistSq = DistSq;
+				BestTarget = TestPawn;
+			}
+		}
+	}
+
+	return BestTarget;
+}
+
+void AShooterBenchmarkDirector::RecordFrame(float DeltaSeconds)
+{
+	int32 NumConnections = 0;
+	int32 FrameOutBytes = 0;
+	int32 MaxConnectionOutBytes = 0;
+
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver)
+	{
+		for (UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			if (Connection == nullptr)
+			{
+				continue;
+			}
+
+			int32& LastBytes = LastOutBytes.FindOrAdd(Connection);
+			const int32 ConnectionOutBytes = Connection->OutBytes >= LastBytes ? Connection->OutBytes - LastBytes : Connection->OutBytes;
+			LastBytes = Connection->OutBytes;
+
+			NumConnections++;
+			FrameOutBytes += ConnectionOutBytes;
+			MaxConnectionOutBytes = FMath::Max(MaxConnectionOutBytes, ConnectionOutBytes);
+		}
+	}
+
+	// a headless run without clients sends nothing, don't report that as 0 bytes
+	const FString OutBytesColumns = NumConnections > 0 ? FString::Printf(TEXT("%d,%d"), FrameOutBytes, MaxConnectionOutBytes) : FString(TEXT("n/a,n/a"));
+	bMeasuredOutBytes |= NumConnections > 0;
+
+	const FString Row = FString::Printf(TEXT("%d,%.3f,%.3f,%.3f,%d,%.3f,%d,%s,%d,%d\n"),
+		NumFrames, GetWorld()->GetTimeSeconds(), DeltaSeconds * 1000.0f, FPlatformTime::ToMilliseconds(GGameThreadTime),
+		FrameSpawns, FrameGCSeconds * 1000.0, NumConnections, *OutBytesColumns, ArmedBots, SkippedBots);
+	CsvFile->Serialize(TCHAR_TO_ANSI(*Row), Row.Len());
+
+	NumFrames++;
+	TotalFrameSeconds += DeltaSeconds;
+	MaxFrameSeconds = FMath::Max(MaxFrameSeconds, (double)DeltaSeconds);
+	TotalSpawns += FrameSpawns;
+	TotalGCSeconds += FrameGCSeconds;
+	TotalOutBytes += FrameOutBytes;
+
+	FrameSpawns = 0;
+	FrameGCSeconds = 0.0;
+}
+
+void AShooterBenchmarkDirector::FinishBenchmark()
+{
+	StopRecording();
+
+	const FString OutBytesSummary = bMeasuredOutBytes ? FString::Printf(TEXT("%lld bytes sent"), TotalOutBytes) : FString(TEXT("bytes sent not measured (no clients)"));
+	UE_LOG(LogShooter, Log, TEXT("Benchmark: %d frames, avg %.2f ms, max %.2f ms, %d spawns, %.2f ms GC, %s, up to %d bots without effect weapon"),
+		NumFrames, NumFrames > 0 ? TotalFrameSeconds * 1000.0 / NumFrames : 0.0, MaxFrameSeconds * 1000.0, TotalSpawns, TotalGCSeconds * 1000.0, *OutBytesSummary, MaxSkippedBots);
+
+	// build boxes run the benchmark standalone and wait for the process to end
+	if (!GIsEditor)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void AShooterBenchmarkDirector::StopRecording()
+{
+	if (CsvFile == nullptr)
+	{
+		return;
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(OnActorSpawnedHandle);
+		GetWorldTimerManager().ClearTimer(TimerHandle_UpdateBots);
+	}
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(OnPreGarbageCollectHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(OnPostGarbageCollectHandle);
+	SetActorTickEnabled(false);
+
+	CsvFile->Close();
+	delete CsvFile;
+	CsvFile = nullptr;
+}
+
+void AShooterBenchmarkDirector::OnActorSpawned(AActor* Actor)
+{
+	FrameSpawns++;
+}
+
+void AShooterBenchmarkDirector::OnPreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void AShooterBenchmarkDirector::OnPostGarbageCollect()
+{
+	if (GCStartTime > 0.0)
+	{
+		FrameGCSeconds += FPlatformTime::Seconds() - GCStartTime;
+		GCStartTime = 0.0;
+	}
+}
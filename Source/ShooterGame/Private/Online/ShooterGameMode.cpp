@@ -8,7 +8,9 @@
 #include "Online/ShooterGameMode.h"
 #include "Online/ShooterPlayerState.h"
 #include "Online/ShooterGameSession.h"
+#include "Online/ShooterBenchmarkDirector.h"
 #include "Bots/ShooterAIController.h"
+#include "Player/ShooterPawnPool.h"
 #include "ShooterTeamStart.h"
 
 
@@ -31,6 +33,7 @@ AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer)
 
 	bAllowBots = true;	
 	bNeedsBotCreation = true;
+	BenchmarkDuration = 0;
 	bUseSeamlessTravel = FParse::Param(FCommandLine::Get(), TEXT("NoSeamlessTravel")) ? false : true;
 }
 
@@ -48,9 +51,17 @@ FString AShooterGameMode::GetBotsCountOptionName()
 	return FString(TEXT("Bots"));
 }
 
+FString AShooterGameMode::GetBenchmarkOptionName()
+{
+	return FString(TEXT("Benchmark"));
+}
+
 void AShooterGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
 {
-	const int32 BotsCountOptionValue = UGameplayStatics::GetIntOption(Options, GetBotsCountOptionName(), 0);
+	BenchmarkDuration = FMath::Max(0, UGameplayStatics::GetIntOption(Options, GetBenchmarkOptionName(), 0));
+
+	// benchmark needs bots to fight each other
+	const int32 BotsCountOptionValue = UGameplayStatics::GetIntOption(Options, GetBotsCountOptionName(), IsBenchmarkMode() ? AShooterBenchmarkDirector::DefaultNumBots : 0);
 	SetAllowBots(BotsCountOptionValue > 0 ? true : false, BotsCountOptionValue);	
 	Super::InitGame(MapName, Options, ErrorMessage);
 
@@ -82,8 +93,8 @@ void AShooterGameMode::PreInitializeComponents()
 
 void AShooterGameMode::DefaultTimer()
 {
-	// don't update timers for Play In Editor mode, it's not real match
-	if (GetWorld()->IsPlayInEditor())
+	// don't update timers for Play In Editor mode or benchmark, it's not real match
+	if (GetWorld()->IsPlayInEditor() || IsBenchmarkMode())
 	{
 		// start match if necessary.
 		if (GetMatchState() == MatchState::WaitingToStart)
@@ -167,6 +178,18 @@ void AShooterGameMode::HandleMatchHasStarted()
 	AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameState);
 	MyGameState->RemainingTime = RoundTime;	
 	StartBots();	
+	PrewarmStatusEffectActors();
+
+	if (IsBenchmarkMode() && BenchmarkDirector == nullptr)
+	{
+		FActorSpawnParameters SpawnInfo;
+		SpawnInfo.Owner = this;
+		BenchmarkDirector = GetWorld()->SpawnActor<AShooterBenchmarkDirector>(SpawnInfo);
+		if (BenchmarkDirector)
+		{
+			BenchmarkDirector->StartBenchmark(BenchmarkDuration);
+		}
+	}
 
 	// notify players
 	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
@@ -179,6 +202,35 @@ void AShooterGameMode::HandleMatchHasStarted()
 	}
 }
 
+void AShooterGameMode::PrewarmStatusEffectActors()
+{
+	UShooterEffectActorPool* EffectActorPool = GetWorld()->GetSubsystem<UShooterEffectActorPool>();
+	if (EffectActorPool == nullptr)
+	{
+		return;
+	}
+
+	// a pawn carries at most one effect at a time, so one actor per pawn and class covers the whole match
+	const int32 NumPawns = FMath::Max(1, GetNumPlayers() + (bAllowBots ? MaxBots : 0));
+
+	TArray<TSubclassOf<AActor>> EffectActorClasses;
+	const AShooterCharacter* PlayerPawnCDO = DefaultPawnClass ? Cast<AShooterCharacter>(DefaultPawnClass->GetDefaultObject()) : nullptr;
+	if (PlayerPawnCDO)
+	{
+		PlayerPawnCDO->GetStatusEffectActorClasses(EffectActorClasses);
+	}
+	const AShooterCharacter* BotPawnCDO = BotPawnClass ? Cast<AShooterCharacter>(BotPawnClass->GetDefaultObject()) : nullptr;
+	if (BotPawnCDO)
+	{
+		BotPawnCDO->GetStatusEffectActorClasses(EffectActorClasses);
+	}
+
+	for (const TSubclassOf<AActor>& EffectActorClass : EffectActorClasses)
+	{
+		EffectActorPool->Prewarm(EffectActorClass, NumPawns);
+	}
+}
+
 void AShooterGameMode::HandleStartingNewPlayer_Implementation(APlayerController* NewPlayer)
 {
 	Super::HandleStartingNewPlayer_Implementation(NewPlayer);
@@ -297,6 +349,19 @@ void AShooterGameMode::PostLogin(APlayerController* NewPlayer)
 	}
 }
 
+void AShooterGameMode::GenericPlayerInitialization(AController* C)
+{
+	Super::GenericPlayerInitialization(C);
+
+	// clients load the configured stats table, not the file reloaded on the server
+	AShooterPlayerController* PC = Cast<AShooterPlayerController>(C);
+	UShooterWeaponStats* WeaponStats = GetWorld()->GetSubsystem<UShooterWeaponStats>();
+	if (PC && WeaponStats)
+	{
+		WeaponStats->SendReloadedStats(PC);
+	}
+}
+
 void AShooterGameMode::Killed(AController* Killer, AController* KilledPlayer, APawn* KilledPawn, const UDamageType* DamageType)
 {
 	AShooterPlayerState* KillerPlayerState = Killer ? Cast<AShooterPlayerState>(Killer->PlayerState) : NULL;
@@ -366,6 +431,21 @@ UClass* AShooterGameMode::GetDefaultPawnClassForController_Implementation(AContr
 	return Super::GetDefaultPawnClassForController_Implementation(InController);
 }
 
+APawn* AShooterGameMode::SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform)
+{
+	UShooterPawnPool* PawnPool = GetWorld()->GetSubsystem<UShooterPawnPool>();
+	if (PawnPool && UShooterPawnPool::IsPoolingEnabled())
+	{
+		if (AShooterCharacter* PooledPawn = PawnPool->AcquirePawn(GetDefaultPawnClassForController(NewPlayer), SpawnTransform))
+		{
+			return PooledPawn;
+		}
+		PawnPool->NotifyPawnSpawned();
+	}
+
+	return Super::SpawnDefaultPawnAtTransform_Implementation(NewPlayer, SpawnTransform);
+}
+
 void AShooterGameMode::RestartPlayer(AController* NewPlayer)
 {
 	Super::RestartPlayer(NewPlayer);
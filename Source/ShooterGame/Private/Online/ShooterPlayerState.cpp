@@ -2,8 +2,15 @@
 
 #include "ShooterGame.h"
 #include "ShooterPlayerState.h"
+#include "Weapons/ShooterWeapon.h"
 #include "Net/OnlineEngineInterface.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapons Reused"), STAT_ShooterWeaponsReused, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Stored Weapons"), STAT_ShooterStoredWeapons, STATGROUP_ShooterGame);
+
+FOnShooterPlayerStateStoredWeapon AShooterPlayerState::NotifyStoreWeapon;
+FOnShooterPlayerStateStoredWeapon AShooterPlayerState::NotifyReleaseWeapon;
+
 AShooterPlayerState::AShooterPlayerState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	TeamNumber = 0;
@@ -27,6 +34,13 @@ void AShooterPlayerState::Reset()
 	bQuitter = false;
 }
 
+void AShooterPlayerState::Destroyed()
+{
+	DestroyStoredWeapons();
+
+	Super::Destroyed();
+}
+
 void AShooterPlayerState::RegisterPlayerWithSession(bool bWasFromInvite)
 {
 	if (UOnlineEngineInterface::Get()->DoesSessionExist(GetWorld(), NAME_GameSession))
@@ -93,6 +107,54 @@ void AShooterPlayerState::CopyProperties(APlayerState* PlayerState)
 	}	
 }
 
+void AShooterPlayerState::StoreWeapon(AShooterWeapon* Weapon)
+{
+	check(Weapon && Weapon->GetPawnOwner() == nullptr);
+
+	Weapon->ResetAmmo();
+
+	// keep the owning connection, so the weapon isn't reopened for it on the next life
+	Weapon->SetOwner(this);
+	StoredWeapons.Add(Weapon);
+	INC_DWORD_STAT(STAT_ShooterStoredWeapons);
+
+	NotifyStoreWeapon.Broadcast(this, Weapon);
+}
+
+AShooterWeapon* AShooterPlayerState::TakeStoredWeapon(TSubclassOf<AShooterWeapon> WeaponClass)
+{
+	for (int32 i = 0; i < StoredWeapons.Num(); i++)
+	{
+		AShooterWeapon* Weapon = StoredWeapons[i];
+		if (IsValid(Weapon) && Weapon->GetClass() == WeaponClass)
+		{
+			StoredWeapons.RemoveAtSwap(i);
+			DEC_DWORD_STAT(STAT_ShooterStoredWeapons);
+			INC_DWORD_STAT(STAT_ShooterWeaponsReused);
+
+			// the weapon keeps replicating with the player state until a pawn equips it, see UShooterReplicationGraph::OnCharacterEquipWeapon
+			return Weapon;
+		}
+	}
+
+	return nullptr;
+}
+
+void AShooterPlayerState::DestroyStoredWeapons()
+{
+	for (AShooterWeapon* Weapon : StoredWeapons)
+	{
+		if (IsValid(Weapon))
+		{
+			NotifyReleaseWeapon.Broadcast(this, Weapon);
+			Weapon->Destroy();
+		}
+	}
+
+	DEC_DWORD_STAT_BY(STAT_ShooterStoredWeapons, StoredWeapons.Num());
+	StoredWeapons.Reset();
+}
+
 void AShooterPlayerState::UpdateTeamColors()
 {
 	AController* OwnerController = Cast<AController>(GetOwner());
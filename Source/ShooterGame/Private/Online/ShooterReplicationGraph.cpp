@@ -50,6 +50,8 @@
 *		the graph leaner since no extra work has to be done for the weapon actors.
 *		
 *		See UShooterReplicationGraph::OnCharacterWeaponChange: this is how actors are added/removed from the dependent actor list. 
+*		Weapons of dead pawns are stored with the AShooterPlayerState and depend on the player state until the next pawn equips them
+*		(see UShooterReplicationGraph::OnPlayerStateStoreWeapon), so their channels stay open across respawns.
 *	
 *	How To Use
 *	
@@ -97,6 +99,7 @@
 #include "Online/ShooterPlayerState.h"
 #include "Weapons/ShooterWeapon.h"
 #include "Pickups/ShooterPickup.h"
+#include "Pickups/ShooterPickup_Weapon.h"
 
 DEFINE_LOG_CATEGORY( LogShooterReplicationGraph );
 
@@ -196,6 +199,7 @@ void UShooterReplicationGraph::InitGlobalActorClassSettings()
 	AddInfo( AReplicationGraphDebugActor::StaticClass(),			EClassRepNodeMapping::NotRouted);				// Not needed. Replicated special case inside RepGraph
 	AddInfo( AInfo::StaticClass(),									EClassRepNodeMapping::RelevantAllConnections);	// Non spatialized, relevant to all
 	AddInfo( AShooterPickup::StaticClass(),							EClassRepNodeMapping::Spatialize_Static);		// Spatialized and never moves. Routes to GridNode.
+	AddInfo( AShooterPickup_Weapon::StaticClass(),					EClassRepNodeMapping::Spatialize_Dynamic);		// Dropped weapons are recycled at new locations. Routes to GridNode.
 
 #if WITH_GAMEPLAY_DEBUGGER
 	AddInfo( AGameplayDebuggerCategoryReplicator::StaticClass(),	EClassRepNodeMapping::NotRouted);				// Replicated via UShooterReplicationGraphNode_AlwaysRelevant_ForConnection
@@ -350,6 +354,8 @@ void UShooterReplicationGraph::InitGlobalActorClassSettings()
 	
 	AShooterCharacter::NotifyEquipWeapon.AddUObject(this, &UShooterReplicationGraph::OnCharacterEquipWeapon);
 	AShooterCharacter::NotifyUnEquipWeapon.AddUObject(this, &UShooterReplicationGraph::OnCharacterUnEquipWeapon);
+	AShooterPlayerState::NotifyStoreWeapon.AddUObject(this, &UShooterReplicationGraph::OnPlayerStateStoreWeapon);
+	AShooterPlayerState::NotifyReleaseWeapon.AddUObject(this, &UShooterReplicationGraph::OnPlayerStateReleaseWeapon);
 
 #if WITH_GAMEPLAY_DEBUGGER
 	AGameplayDebuggerCategoryReplicator::NotifyDebuggerOwnerChange.AddUObject(this, &UShooterReplicationGraph::OnGameplayDebuggerOwnerChange);
@@ -511,6 +517,12 @@ void UShooterReplicationGraph::OnCharacterEquipWeapon(AShooterCharacter* Charact
 		CHECK_WORLDS(Character);
 
 		GlobalActorReplicationInfoMap.AddDependentActor(Character, NewWeapon);
+
+		// a weapon taken back from the player state replicated with it until now
+		if (AShooterPlayerState* PlayerState = Character->GetPlayerState<AShooterPlayerState>())
+		{
+			GlobalActorReplicationInfoMap.RemoveDependentActor(PlayerState, NewWeapon);
+		}
 	}
 }
 
@@ -524,6 +536,27 @@ void UShooterReplicationGraph::OnCharacterUnEquipWeapon(AShooterCharacter* Chara
 	}
 }
 
+void UShooterReplicationGraph::OnPlayerStateStoreWeapon(AShooterPlayerState* PlayerState, AShooterWeapon* Weapon)
+{
+	if (PlayerState && Weapon)
+	{
+		CHECK_WORLDS(PlayerState);
+
+		// player states never time out their channels, stored weapons ride along until the next pawn equips them
+		GlobalActorReplicationInfoMap.AddDependentActor(PlayerState, Weapon);
+	}
+}
+
+void UShooterReplicationGraph::OnPlayerStateReleaseWeapon(AShooterPlayerState* PlayerState, AShooterWeapon* Weapon)
+{
+	if (PlayerState && Weapon)
+	{
+		CHECK_WORLDS(PlayerState);
+
+		GlobalActorReplicationInfoMap.RemoveDependentActor(PlayerState, Weapon);
+	}
+}
+
 #if WITH_GAMEPLAY_DEBUGGER
 void UShooterReplicationGraph::OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner)
 {
@@ -8,6 +8,7 @@
 
 class AShooterCharacter;
 class AShooterWeapon;
+class AShooterPlayerState;
 class UReplicationGraphNode_GridSpatialization2D;
 class AGameplayDebuggerCategoryReplicator;
 
@@ -64,6 +65,8 @@ public:
 
 	void OnCharacterEquipWeapon(AShooterCharacter* Character, AShooterWeapon* NewWeapon);
 	void OnCharacterUnEquipWeapon(AShooterCharacter* Character, AShooterWeapon* OldWeapon);
+	void OnPlayerStateStoreWeapon(AShooterPlayerState* PlayerState, AShooterWeapon* Weapon);
+	void OnPlayerStateReleaseWeapon(AShooterPlayerState* PlayerState, AShooterWeapon* Weapon);
 
 #if WITH_GAMEPLAY_DEBUGGER
 	void OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner);
@@ -0,0 +1,196 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Pickups/ShooterDroppedWeaponManager.h"
+#include "Pickups/ShooterPickup_Weapon.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dropped Weapons Evicted"), STAT_ShooterDroppedWeaponsEvicted, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dropped Weapons Active"), STAT_ShooterDroppedWeaponsActive, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dropped Weapon Pickups Idle"), STAT_ShooterDroppedWeaponsIdle, STATGROUP_ShooterGame);
+
+static int32 MaxDroppedWeapons = 16;
+FAutoConsoleVariableRef CVarMaxDroppedWeapons(
+	TEXT("ShooterGame.MaxDroppedWeapons"),
+	MaxDroppedWeapons,
+	TEXT("Max number of dropped weapon pickups in the world, older drops get recycled."),
+	ECVF_Default);
+
+static int32 DroppedWeaponEviction = EShooterDropEviction::Oldest;
+FAutoConsoleVariableRef CVarDroppedWeaponEviction(
+	TEXT("ShooterGame.DroppedWeaponEviction"),
+	DroppedWeaponEviction,
+	TEXT("Which drop is recycled when the cap is reached.\n")
+	TEXT("0: Oldest, 1: Farthest from living characters"),
+	ECVF_Default);
+
+bool UShooterDroppedWeaponManager::ShouldCreateSubsystem(UObject* Outer) const
+{
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UShooterDroppedWeaponManager::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_ShooterDroppedWeaponsActive, ActiveDrops.Num());
+	DEC_DWORD_STAT_BY(STAT_ShooterDroppedWeaponsIdle, IdlePickups.Num());
+
+	// pickups are owned by the level and go away with it
+	ActiveDrops.Empty();
+	IdlePickups.Empty();
+
+	Super::Deinitialize();
+}
+
+AShooterPickup_Weapon* UShooterDroppedWeaponManager::DropWeapon(TSubclassOf<AShooterPickup_Weapon> PickupClass, TSubclassOf<AShooterWeapon> WeaponClass, const FVector& Location, int32 Ammo, int32 AmmoInClip)
+{
+	if (PickupClass == nullptr || WeaponClass == nullptr || Ammo <= 0)
+	{
+		return nullptr;
+	}
+
+	// pickups destroyed by someone else
+	const int32 NumRemoved = ActiveDrops.RemoveAll([](const AShooterPickup_Weapon* Pickup) { return !IsValid(Pickup); });
+	DEC_DWORD_STAT_BY(STAT_ShooterDroppedWeaponsActive, NumRemoved);
+
+	AShooterPickup_Weapon* Pickup = nullptr;
+	while (ActiveDrops.Num() >= FMath::Max(1, MaxDroppedWeapons) && Pickup == nullptr)
+	{
+		const int32 EvictIdx = FindDropToEvict();
+		AShooterPickup_Weapon* Evicted = ActiveDrops[EvictIdx];
+		ActiveDrops.RemoveAt(EvictIdx);
+		DEC_DWORD_STAT(STAT_ShooterDroppedWeaponsActive);
+
+		NumEvicted++;
+		INC_DWORD_STAT(STAT_ShooterDroppedWeaponsEvicted);
+
+		Evicted->DeactivateDrop();
+		if (Evicted->GetClass() == PickupClass)
+		{
+			Pickup = Evicted;
+		}
+		else
+		{
+			IdlePickups.Add(Evicted);
+			INC_DWORD_STAT(STAT_ShooterDroppedWeaponsIdle);
+		}
+	}
+
+	if (Pickup == nullptr)
+	{
+		Pickup = TakeIdlePickup(PickupClass);
+	}
+
+	if (Pickup)
+	{
+		Pickup->ActivateDrop(WeaponClass, Ammo, AmmoInClip, Location);
+	}
+	else
+	{
+		Pickup = GetWorld()->SpawnActorDeferred<AShooterPickup_Weapon>(PickupClass, FTransform(Location), nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (Pickup == nullptr)
+		{
+			return nullptr;
+		}
+
+		// weapon exists before BeginPlay checks for overlapping characters
+		Pickup->ActivateDrop(WeaponClass, Ammo, AmmoInClip, Location);
+		Pickup->FinishSpawning(FTransform(Location));
+		NumSpawned++;
+	}
+
+	ActiveDrops.Add(Pickup);
+	INC_DWORD_STAT(STAT_ShooterDroppedWeaponsActive);
+	return Pickup;
+}
+
+bool UShooterDroppedWeaponManager::ReleaseDrop(AShooterPickup_Weapon* Pickup)
+{
+	if (ActiveDrops.RemoveSingle(Pickup) == 0)
+	{
+		return false;
+	}
+
+	DEC_DWORD_STAT(STAT_ShooterDroppedWeaponsActive);
+
+	Pickup->DeactivateDrop();
+	IdlePickups.Add(Pickup);
+	INC_DWORD_STAT(STAT_ShooterDroppedWeaponsIdle);
+	return true;
+}
+
+void UShooterDroppedWeaponManager::DumpStats() const
+{
+	UE_LOG(LogShooter, Log, TEXT("Dropped weapons: %d active, %d idle, %d spawned, %d evicted (cap %d)"), ActiveDrops.Num(), IdlePickups.Num(), NumSpawned, NumEvicted, MaxDroppedWeapons);
+}
+
+int32 UShooterDroppedWeaponManager::FindDropToEvict() const
+{
+	if (DroppedWeaponEviction != EShooterDropEviction::FarthestFromPlayers)
+	{
+		return 0;
+	}
+
+	TArray<FVector> CharacterLocations;
+	for (AShooterCharacter* Character : TActorRange<AShooterCharacter>(GetWorld()))
+	{
+		if (Character->IsAlive())
+		{
+			CharacterLocations.Add(Character->GetActorLocation());
+		}
+	}
+
+	if (CharacterLocations.Num() == 0)
+	{
+		return 0;
+	}
+
+	// ties keep the older drop
+	int32 BestIdx = 0;
+	float BestDistSq = -1.0f;
+	for (int32 DropIdx = 0; DropIdx < ActiveDrops.Num(); DropIdx++)
+	{
+		const FVector DropLocation = ActiveDrops[DropIdx]->GetActorLocation();
+		float ClosestDistSq = MAX_FLT;
+		for (const FVector& CharacterLocation : CharacterLocations)
+		{
+			ClosestDistSq = FMath::Min(ClosestDistSq, FVector::DistSquared(DropLocation, CharacterLocation));
+		}
+
+		if (ClosestDistSq > BestDistSq)
+		{
+			BestDistSq = ClosestDistSq;
+			BestIdx = DropIdx;
+		}
+	}
+
+	return BestIdx;
+}
+
+AShooterPickup_Weapon* UShooterDroppedWeaponManager::TakeIdlePickup(UClass* PickupClass)
+{
+	for (int32 PickupIdx = IdlePickups.Num() - 1; PickupIdx >= 0; PickupIdx--)
+	{
+		AShooterPickup_Weapon* Pickup = IdlePickups[PickupIdx];
+		if (!IsValid(Pickup) || Pickup->GetClass() == PickupClass)
+		{
+			IdlePickups.RemoveAtSwap(PickupIdx);
+			DEC_DWORD_STAT(STAT_ShooterDroppedWeaponsIdle);
+			if (IsValid(Pickup))
+			{
+				return Pickup;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+FAutoConsoleCommandWithWorld ShooterDumpDroppedWeaponsCmd(TEXT("ShooterGame.DumpDroppedWeapons"), TEXT("Prints dropped weapon pickup counts"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UShooterDroppedWeaponManager* Manager = World ? World->GetSubsystem<UShooterDroppedWeaponManager>() : nullptr)
+		{
+			Manager->DumpStats();
+		}
+	})
+);
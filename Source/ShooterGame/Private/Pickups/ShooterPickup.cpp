@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "Pickups/ShooterPickup.h"
+#include "Pickups/ShooterPickupRegistry.h"
 #include "Particles/ParticleSystemComponent.h"
 
 AShooterPickup::AShooterPickup(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -39,6 +40,24 @@ void AShooterPickup::BeginPlay()
 	{
 		GameMode->LevelPickups.Add(this);
 	}
+
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		if (UShooterPickupRegistry* PickupRegistry = GetWorld()->GetSubsystem<UShooterPickupRegistry>())
+		{
+			PickupRegistry->RegisterPickup(this);
+		}
+	}
+}
+
+void AShooterPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UShooterPickupRegistry* PickupRegistry = GetWorld()->GetSubsystem<UShooterPickupRegistry>())
+	{
+		PickupRegistry->UnregisterPickup(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AShooterPickup::NotifyActorBeginOverlap(class AActor* Other)
@@ -0,0 +1,233 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Pickups/ShooterPickupRegistry.h"
+#include "Pickups/ShooterPickup_Ammo.h"
+#include "Pickups/ShooterPickup_Health.h"
+#include "Pickups/ShooterPickup_Weapon.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered Pickups"), STAT_ShooterRegisteredPickups, STATGROUP_ShooterGame);
+
+void FShooterPickupGrid::Add(AShooterPickup* Pickup, const FIntPoint& Cell)
+{
+	Cells.FindOrAdd(Cell).Add(Pickup);
+	MinCell = FIntPoint(FMath::Min(MinCell.X, Cell.X), FMath::Min(MinCell.Y, Cell.Y));
+	MaxCell = FIntPoint(FMath::Max(MaxCell.X, Cell.X), FMath::Max(MaxCell.Y, Cell.Y));
+	Num++;
+}
+
+void FShooterPickupGrid::Remove(AShooterPickup* Pickup, const FIntPoint& Cell)
+{
+	TArray<AShooterPickup*>* CellPickups = Cells.Find(Cell);
+	if (CellPickups && CellPickups->RemoveSingleSwap(Pickup) > 0)
+	{
+		Num--;
+		if (CellPickups->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+AShooterPickup* FShooterPickupGrid::FindNearest(const FVector& Location, TFunctionRef<bool(AShooterPickup*)> Predicate, float& InOutBestDistSq) const
+{
+	if (Num == 0)
+	{
+		return nullptr;
+	}
+
+	const FIntPoint Center = UShooterPickupRegistry::GetCell(Location);
+	const int32 MaxRing = FMath::Max(
+		FMath::Max(Center.X - MinCell.X, MaxCell.X - Center.X),
+		FMath::Max(Center.Y - MinCell.Y, MaxCell.Y - Center.Y));
+
+	AShooterPickup* BestPickup = nullptr;
+	auto VisitCell = [&](int32 X, int32 Y)
+	{
+		if (X < MinCell.X || X > MaxCell.X || Y < MinCell.Y || Y > MaxCell.Y)
+		{
+			return;
+		}
+
+		const TArray<AShooterPickup*>* CellPickups = Cells.Find(FIntPoint(X, Y));
+		if (CellPickups == nullptr)
+		{
+			return;
+		}
+
+		for (AShooterPickup* Pickup : *CellPickups)
+		{
+			const float DistSq = FVector::DistSquared(Pickup->GetActorLocation(), Location);
+			if (DistSq < InOutBestDistSq && Predicate(Pickup))
+			{
+				InOutBestDistSq = DistSq;
+				BestPickup = Pickup;
+			}
+		}
+	};
+
+	for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		// everything in this ring or further out is at least (Ring - 1) cells away
+		if (Ring > 0 && InOutBestDistSq <= FMath::Square((Ring - 1) * UShooterPickupRegistry::CellSize))
+		{
+			break;
+		}
+
+		if (Ring == 0)
+		{
+			VisitCell(Center.X, Center.Y);
+			continue;
+		}
+
+		for (int32 X = -Ring; X <= Ring; X++)
+		{
+			VisitCell(Center.X + X, Center.Y - Ring);
+			VisitCell(Center.X + X, Center.Y + Ring);
+		}
+		for (int32 Y = -Ring + 1; Y < Ring; Y++)
+		{
+			VisitCell(Center.X - Ring, Center.Y + Y);
+			VisitCell(Center.X + Ring, Center.Y + Y);
+		}
+	}
+
+	return BestPickup;
+}
+
+bool UShooterPickupRegistry::ShouldCreateSubsystem(UObject* Outer) const
+{
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UShooterPickupRegistry::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_ShooterRegisteredPickups, Registered.Num());
+
+	AmmoGrids.Empty();
+	HealthGrid = FShooterPickupGrid();
+	WeaponGrid = FShooterPickupGrid();
+	Registered.Empty();
+
+	Super::Deinitialize();
+}
+
+void UShooterPickupRegistry::RegisterPickup(AShooterPickup* Pickup)
+{
+	if (Pickup == nullptr)
+	{
+		return;
+	}
+
+	UClass* BucketClass = nullptr;
+	const EShooterPickupType::Type Type = GetPickupType(Pickup, BucketClass);
+	if (Type == EShooterPickupType::MAX)
+	{
+		return;
+	}
+
+	const FIntPoint Cell = GetCell(Pickup->GetActorLocation());
+	if (FRegisteredPickup* Existing = Registered.Find(Pickup))
+	{
+		if (Existing->Type == Type && Existing->BucketClass == BucketClass && Existing->Cell == Cell)
+		{
+			return;
+		}
+
+		GetGrid(Existing->Type, Existing->BucketClass).Remove(Pickup, Existing->Cell);
+		Existing->Type = Type;
+		Existing->BucketClass = BucketClass;
+		Existing->Cell = Cell;
+	}
+	else
+	{
+		FRegisteredPickup& NewEntry = Registered.Add(Pickup);
+		NewEntry.Type = Type;
+		NewEntry.BucketClass = BucketClass;
+		NewEntry.Cell = Cell;
+		INC_DWORD_STAT(STAT_ShooterRegisteredPickups);
+	}
+
+	GetGrid(Type, BucketClass).Add(Pickup, Cell);
+}
+
+void UShooterPickupRegistry::UnregisterPickup(AShooterPickup* Pickup)
+{
+	FRegisteredPickup Entry;
+	if (Registered.RemoveAndCopyValue(Pickup, Entry))
+	{
+		GetGrid(Entry.Type, Entry.BucketClass).Remove(Pickup, Entry.Cell);
+		DEC_DWORD_STAT(STAT_ShooterRegisteredPickups);
+	}
+}
+
+AShooterPickup* UShooterPickupRegistry::FindNearest(EShooterPickupType::Type Type, UClass* WeaponClass, const FVector& Location, AShooterCharacter* ForPawn) const
+{
+	auto CanUse = [ForPawn](AShooterPickup* Pickup)
+	{
+		return Pickup->IsPickupActive() && Pickup->CanBePickedUp(ForPawn);
+	};
+
+	float BestDistSq = MAX_FLT;
+	AShooterPickup* BestPickup = nullptr;
+	if (Type == EShooterPickupType::Ammo)
+	{
+		// few ammo types, check every bucket for a matching weapon
+		for (const auto& It : AmmoGrids)
+		{
+			if (WeaponClass == nullptr || (It.Key && It.Key->IsChildOf(WeaponClass)))
+			{
+				if (AShooterPickup* Found = It.Value.FindNearest(Location, CanUse, BestDistSq))
+				{
+					BestPickup = Found;
+				}
+			}
+		}
+	}
+	else if (Type == EShooterPickupType::Health)
+	{
+		BestPickup = HealthGrid.FindNearest(Location, CanUse, BestDistSq);
+	}
+	else if (Type == EShooterPickupType::Weapon)
+	{
+		BestPickup = WeaponGrid.FindNearest(Location, CanUse, BestDistSq);
+	}
+
+	return BestPickup;
+}
+
+FIntPoint UShooterPickupRegistry::GetCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+EShooterPickupType::Type UShooterPickupRegistry::GetPickupType(const AShooterPickup* Pickup, UClass*& OutBucketClass)
+{
+	OutBucketClass = nullptr;
+	if (const AShooterPickup_Ammo* AmmoPickup = Cast<AShooterPickup_Ammo>(Pickup))
+	{
+		OutBucketClass = AmmoPickup->GetWeaponType();
+		return EShooterPickupType::Ammo;
+	}
+	if (Pickup->IsA<AShooterPickup_Health>())
+	{
+		return EShooterPickupType::Health;
+	}
+	if (Pickup->IsA<AShooterPickup_Weapon>())
+	{
+		return EShooterPickupType::Weapon;
+	}
+
+	return EShooterPickupType::MAX;
+}
+
+FShooterPickupGrid& UShooterPickupRegistry::GetGrid(EShooterPickupType::Type Type, UClass* BucketClass)
+{
+	if (Type == EShooterPickupType::Ammo)
+	{
+		return AmmoGrids.FindOrAdd(BucketClass);
+	}
+
+	return Type == EShooterPickupType::Health ? HealthGrid : WeaponGrid;
+}
@@ -3,15 +3,22 @@
 #include "ShooterGame.h"
 #include "ShooterWeapon.h"
 #include "Pickups/ShooterPickup_Weapon.h"
+#include "Pickups/ShooterDroppedWeaponManager.h"
+#include "Pickups/ShooterPickupRegistry.h"
+#include "Online/ShooterPlayerState.h"
 
 AShooterPickup_Weapon::AShooterPickup_Weapon(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
+	//Dropped weapons don't respawn, taken pickups go back to the dropped weapon manager.
+	RespawnTime = 0.0f;
+	//Recycled pickups move to the new drop location.
+	SetReplicateMovement(true);
 }
 
 bool AShooterPickup_Weapon::CanBePickedUp(AShooterCharacter* TestPawn) const
 {
-	//Any alive player, with enough space in inventory, can pick up the weapon.
-	if (TestPawn->IsAlive() && TestPawn->GetInventoryCount() < TestPawn->GetMaxWeaponsCount())
+	//Any alive player, with enough space in inventory, can pick up a weapon with ammo.
+	if (!bPickedUp && HasWeapon() && TestPawn->IsAlive() && TestPawn->GetInventoryCount() < TestPawn->GetMaxWeaponsCount())
 	{
 		return true;
 	}
@@ -19,37 +26,102 @@ bool AShooterPickup_Weapon::CanBePickedUp(AShooterCharacter* TestPawn) const
 	return false;
 }
 
-void AShooterPickup_Weapon::EndPlay(EEndPlayReason::Type EndReason)
+void AShooterPickup_Weapon::ActivateDrop(TSubclassOf<AShooterWeapon> InWeaponClass, int32 InAmmo, int32 InAmmoInClip, const FVector& Location)
 {
-	if (GetLocalRole() == ROLE_Authority)
+	WeaponClass = InWeaponClass;
+	Ammo = InAmmo;
+	CurrentAmmoInClip = InAmmoInClip;
+	bPickedUp = false;
+	SetActorLocation(Location);
+
+	//Pickups spawned for this drop become active in BeginPlay.
+	if (HasActorBegunPlay())
 	{
-		//If no one picked up the weapon and its valid, destroy it. Notice it only spawns on server side.
-		if (!bPickedUp && IsValid(SpawnedWeapon))
+		GetWorldTimerManager().ClearTimer(TimerHandle_RespawnPickup);
+		SetActorHiddenInGame(false);
+		SetActorEnableCollision(true);
+		RespawnPickup();
+		//New pickups start their life span in BeginPlay.
+		SetLifeSpan(InitialLifeSpan);
+
+		//Moved to the new drop location.
+		if (UShooterPickupRegistry* PickupRegistry = GetWorld()->GetSubsystem<UShooterPickupRegistry>())
 		{
-			SpawnedWeapon->Destroy();
+			PickupRegistry->RegisterPickup(this);
 		}
 	}
+}
+
+void AShooterPickup_Weapon::DeactivateDrop()
+{
+	WeaponClass = nullptr;
+	Ammo = 0;
+	CurrentAmmoInClip = 0;
+	bPickedUp = false;
+
+	GetWorldTimerManager().ClearTimer(TimerHandle_RespawnPickup);
+	SetLifeSpan(0.0f);
+	bIsActive = false;
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
 
-	Super::EndPlay(EndReason);
+	if (UShooterPickupRegistry* PickupRegistry = GetWorld()->GetSubsystem<UShooterPickupRegistry>())
+	{
+		PickupRegistry->UnregisterPickup(this);
+	}
+}
+
+bool AShooterPickup_Weapon::HasWeapon() const
+{
+	return IsValid(WeaponClass) && Ammo > 0;
 }
 
 void AShooterPickup_Weapon::Initialization()
 {
-	//Spawn the weapon, make sure the weapon class is valid and not zero ammo.
-	if (IsValid(WeaponClass) && Ammo > 0)
+	//Nothing to spawn here anymore, the weapon only exists once someone picks it up.
+}
+
+void AShooterPickup_Weapon::GivePickupTo(AShooterCharacter* Pawn)
+{
+	//Reuse a weapon of the same class the player had in an earlier life, or spawn it now that someone takes it.
+	AShooterPlayerState* PlayerState = Pawn->GetPlayerState<AShooterPlayerState>();
+	AShooterWeapon* NewWeapon = PlayerState ? PlayerState->TakeStoredWeapon(WeaponClass) : nullptr;
+	if (NewWeapon == nullptr)
 	{
 		FActorSpawnParameters SpawnInfo;
 		SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-		SpawnedWeapon = GetWorld()->SpawnActor<AShooterWeapon>(WeaponClass, SpawnInfo);
-		SpawnedWeapon->SetAmmo(Ammo);
-		SpawnedWeapon->SetAmmoInClip(CurrentAmmoInClip);
-	}	
+		NewWeapon = GetWorld()->SpawnActor<AShooterWeapon>(WeaponClass, SpawnInfo);
+	}
+	if (NewWeapon)
+	{
+		NewWeapon->SetAmmo(Ammo);
+		NewWeapon->SetAmmoInClip(CurrentAmmoInClip);
+
+		//Add the weapon to the specified player.
+		Pawn->AddWeapon(NewWeapon);
+	}
+	else
+	{
+		UE_LOG(LogShooterWeapon, Warning, TEXT("%s failed to spawn %s for %s, the drop is discarded"), *GetName(), *GetNameSafe(WeaponClass), *GetNameSafe(Pawn));
+	}
+	//Weapon was picked up, or can't be given to anyone.
+	bPickedUp = true;
+
+	//Hand the pickup back for reuse, also when the spawn failed so the manager doesn't keep it as an active drop.
+	if (UShooterDroppedWeaponManager* DroppedWeaponManager = GetWorld()->GetSubsystem<UShooterDroppedWeaponManager>())
+	{
+		DroppedWeaponManager->ReleaseDrop(this);
+	}
 }
 
-void AShooterPickup_Weapon::GivePickupTo(AShooterCharacter* Pawn)
+void AShooterPickup_Weapon::LifeSpanExpired()
 {
-	//Add the weapon to the specified player.
-	Pawn->AddWeapon(SpawnedWeapon);
-	//Weapon was picked up.
-	bPickedUp = true;
+	//Hide drops the manager owns so they can be reused, the manager would otherwise keep a destroyed pickup.
+	UShooterDroppedWeaponManager* DroppedWeaponManager = GetWorld()->GetSubsystem<UShooterDroppedWeaponManager>();
+	if (DroppedWeaponManager && DroppedWeaponManager->ReleaseDrop(this))
+	{
+		return;
+	}
+
+	Super::LifeSpanExpired();
 }
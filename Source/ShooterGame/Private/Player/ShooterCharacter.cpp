@@ -10,6 +10,12 @@
 #include "Sound/SoundNodeLocalPlayer.h"
 #include "AudioThread.h"
 #include "Blueprint/UserWidget.h"
+#include "Player/ShooterStatusEffectComponent.h"
+#include "UI/ShooterEffectOverlayCache.h"
+#include "Pickups/ShooterDroppedWeaponManager.h"
+#include "Pickups/ShooterPickup_Weapon.h"
+#include "Player/ShooterLagCompensation.h"
+#include "Player/ShooterPawnPool.h"
 
 static int32 NetVisualizeRelevancyTestPoints = 0;
 FAutoConsoleVariableRef CVarNetVisualizeRelevancyTestPoints(
@@ -28,6 +34,13 @@ FAutoConsoleVariableRef CVarNetEnablePauseRelevancy(
 	TEXT("0: Disable, 1: Enable"),
 	ECVF_Cheat);
 
+static int32 KeepWeaponsOnRespawn = 1;
+FAutoConsoleVariableRef CVarKeepWeaponsOnRespawn(
+	TEXT("ShooterGame.KeepWeaponsOnRespawn"),
+	KeepWeaponsOnRespawn,
+	TEXT("Keep weapons of dead pawns with the player state and give them to the next pawn instead of spawning new ones."),
+	ECVF_Default);
+
 FOnShooterCharacterEquipWeapon AShooterCharacter::NotifyEquipWeapon;
 FOnShooterCharacterUnEquipWeapon AShooterCharacter::NotifyUnEquipWeapon;
 
@@ -63,6 +76,8 @@ AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer
 	FPSCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
 	FPSCamera->SetupAttachment(GetCapsuleComponent());
 
+	StatusEffects = CreateDefaultSubobject<UShooterStatusEffectComponent>(TEXT("StatusEffects"));
+
 	TargetingSpeedModifier = 0.5f;
 	bIsTargeting = false;
 	RunningSpeedModifier = 1.5f;
@@ -72,6 +87,10 @@ AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer
 
 	BaseTurnRate = 45.f;
 	BaseLookUpRate = 45.f;
+
+	//Dropped weapons use the same pickup the blueprints used to spawn.
+	static ConstructorHelpers::FClassFinder<AShooterPickup_Weapon> DroppedWeaponPickupOb(TEXT("/Game/Blueprints/Pickups/Pickup_Gun"));
+	DroppedWeaponPickupClass = DroppedWeaponPickupOb.Class;
 }
 
 void AShooterCharacter::PostInitializeComponents()
@@ -84,18 +103,30 @@ void AShooterCharacter::PostInitializeComponents()
 
 		// Needs to happen after character is added to repgraph
 		GetWorldTimerManager().SetTimerForNextTick(this, &AShooterCharacter::SpawnDefaultInventory);
+
+		// record hitbox for client hit verification
+		if (UShooterLagCompensation* LagCompensation = GetWorld()->GetSubsystem<UShooterLagCompensation>())
+		{
+			LagCompensation->RegisterPawn(this);
+		}
 	}
 
 	// set initial mesh visibility (3rd person view)
 	UpdatePawnMeshes();
 
+	StatusEffects->OnEffectChanged.AddUObject(this, &AShooterCharacter::OnStatusEffectChanged);
+
 	// create material instance for setting team colors (3rd person view)
 	for (int32 iMat = 0; iMat < GetMesh()->GetNumMaterials(); iMat++)
 	{
 		MeshMIDs.Add(GetMesh()->CreateAndSetMaterialInstanceDynamic(iMat));
 	}
 
-	// play respawn effects
+	PlayRespawnEffects();
+}
+
+void AShooterCharacter::PlayRespawnEffects()
+{
 	if (GetNetMode() != NM_DedicatedServer)
 	{
 		if (RespawnFX)
@@ -114,6 +145,13 @@ void AShooterCharacter::Destroyed()
 {
 	Super::Destroyed();
 	DestroyInventory();
+
+	// effect actors are pooled, don't leave them attached to a destroyed pawn
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		ReleaseEffectActor(FreezeActor);
+		ReleaseEffectActor(ShrinkActor);
+	}
 }
 
 void AShooterCharacter::PawnClientRestart()
@@ -343,26 +381,43 @@ void AShooterCharacter::OnDeath(float KillingDamage, struct FDamageEvent const&
 	}
 
 	SetReplicatingMovement(false);
-	TearOff();
+
+	// pooled pawns keep replicating, so clients can bring them back when they respawn
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		bReturnToPawnPool = UShooterPawnPool::IsPoolingEnabled();
+	}
+	if (!bReturnToPawnPool)
+	{
+		TearOff();
+	}
 	bIsDying = true;
 
+	//End any active effect. Torn off pawns don't receive replication anymore, so clients end them locally as well.
+	StatusEffects->RemoveAllEffects();
+
 	if (GetLocalRole() == ROLE_Authority)
 	{
-		//Destroy any attached actors when player dies. Notice they can be attached only if any effect is active at moment of death.
-		if (bIsAnyEffectActive_Server)
+		if (UShooterLagCompensation* LagCompensation = GetWorld()->GetSubsystem<UShooterLagCompensation>())
 		{
-			TArray<AActor*> AttachedActors;
-			GetAttachedActors(AttachedActors);
-			for (const auto& Actor : AttachedActors)
-			{
-				Actor->Destroy();
-			}
+			LagCompensation->UnregisterPawn(this);
 		}
 
 		//Get the weapon the player held when died.
 		AShooterWeapon* HeldWeapon = GetWeapon();
-		//We call the event on blueprints since the spawn actor will be a blueprint actor.
-		Server_CharacterDied(HeldWeapon->GetClass(), GetActorLocation(), HeldWeapon->GetCurrentAmmo(), HeldWeapon->GetCurrentAmmoInClip());
+		if (HeldWeapon)
+		{
+			//Drops are capped and recycled by the manager. Without a pickup class, let blueprints spawn it.
+			UShooterDroppedWeaponManager* DroppedWeaponManager = GetWorld()->GetSubsystem<UShooterDroppedWeaponManager>();
+			if (DroppedWeaponPickupClass && DroppedWeaponManager)
+			{
+				DroppedWeaponManager->DropWeapon(DroppedWeaponPickupClass, HeldWeapon->GetClass(), GetActorLocation(), HeldWeapon->GetCurrentAmmo(), HeldWeapon->GetCurrentAmmoInClip());
+			}
+			else
+			{
+				Server_CharacterDied(HeldWeapon->GetClass(), GetActorLocation(), HeldWeapon->GetCurrentAmmo(), HeldWeapon->GetCurrentAmmoInClip());
+			}
+		}
 
 		ReplicateHit(KillingDamage, DamageEvent, PawnInstigator, DamageCauser, true);
 
@@ -461,16 +516,14 @@ void AShooterCharacter::PlayHit(float DamageTaken, struct FDamageEvent const& Da
 					PC->ClientPlayForceFeedback(DamageType->HitForceFeedback, FFParams);
 				}
 
-				//If damage is of freeze type, then run server side handling.
+				//If damage is of freeze type, then start the effect. It is ignored while another effect is active.
 				if (DamageType->bFreezeEffect && IsValid(FreezeActorClass))
 				{
-					AShooterCharacter* DamagedCharacter = Cast<AShooterCharacter>(PC->GetPawn());
-					Server_FreezePlayer(DamagedCharacter);
+					StatusEffects->ApplyEffect(EShooterStatusEffect::Freeze, FreezeTime);
 				}
 				else if (DamageType->bShrinkEffect && IsValid(ShrinkActorClass))
 				{
-					AShooterCharacter* DamagedCharacter = Cast<AShooterCharacter>(PC->GetPawn());
-					Server_ShrinkPlayer(DamagedCharacter);
+					StatusEffects->ApplyEffect(EShooterStatusEffect::Shrink, ShrinkTime);
 				}
 			}
 			else
@@ -491,19 +544,7 @@ void AShooterCharacter::PlayHit(float DamageTaken, struct FDamageEvent const& Da
 	if (MyHUD)
 	{
 		//This section of the code is executed only for the damaged client.
-		//Here we will add all our modifications which should occur on hit.
-
-		UShooterDamageType* DamageType = Cast<UShooterDamageType>(DamageEvent.DamageTypeClass->GetDefaultObject());
-		if (DamageType->bFreezeEffect)
-		{
-			//If damage is freeze type, then freeze the player.
-			FreezePlayer();
-		}
-		else if (DamageType->bShrinkEffect)
-		{
-			ShrinkPlayer();
-		}
-
+		//Freeze and shrink are started from OnStatusEffectChanged once the server applied them.
 		MyHUD->NotifyWeaponHit(DamageTaken, DamageEvent, PawnInstigator);
 	}
 
@@ -544,7 +585,19 @@ void AShooterCharacter::SetRagdollPhysics()
 	GetCharacterMovement()->DisableMovement();
 	GetCharacterMovement()->SetComponentTickEnabled(false);
 
-	if (!bInRagdoll)
+	if (bReturnToPawnPool)
+	{
+		// hidden and kept for a later respawn instead of destroyed
+		if (bInRagdoll)
+		{
+			GetWorldTimerManager().SetTimer(TimerHandle_EnterPawnPool, this, &AShooterCharacter::EnterPawnPool, UShooterPawnPool::GetRagdollTime(), false);
+		}
+		else if (!IsPendingKill())
+		{
+			EnterPawnPool();
+		}
+	}
+	else if (!bInRagdoll)
 	{
 		// hide and set short lifespan
 		TurnOff();
@@ -600,163 +653,354 @@ void AShooterCharacter::OnRep_LastTakeHitInfo()
 //////////////////////////////////////////////////////////////////////////
 // General functions.
 
-AActor* AShooterCharacter::SpawnAndAttachActor(const TSubclassOf<AActor> ActorClass, AActor* Target, const float LifeSpan) const
+AActor* AShooterCharacter::AcquireAttachedEffectActor(const TSubclassOf<AActor> ActorClass, AActor* Target, const float LifeSpan, FOnPooledEffectReleased OnReleased) const
 {
-	//Spawn the actor over the player's location.
-	FTransform SpawnTransform;
-	SpawnTransform.SetLocation(Target->GetActorLocation());
-	FActorSpawnParameters SpawnParameters;
-	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	AActor* SpawnedActor = GetWorld()->SpawnActor<AActor>(ActorClass, SpawnTransform, SpawnParameters);
-	//Attach the actor to the player's pawn.
-	FAttachmentTransformRules AttachmentRules = FAttachmentTransformRules::KeepWorldTransform;
-	SpawnedActor->AttachToActor(Target, AttachmentRules);
-	//Set the life span to be the freeze time.
-	SpawnedActor->SetLifeSpan(LifeSpan);
-	return SpawnedActor;
+	//Reuse a pooled actor instead of spawning one per hit. The pool attaches it over the target and releases it after the effect time.
+	UShooterEffectActorPool* EffectActorPool = GetWorld()->GetSubsystem<UShooterEffectActorPool>();
+	checkf(EffectActorPool, TEXT("No effect actor pool in this world"));
+	return EffectActorPool->AcquireAttached(ActorClass, Target, LifeSpan, OnReleased);
+}
+
+void AShooterCharacter::GetStatusEffectActorClasses(TArray<TSubclassOf<AActor>>& OutClasses) const
+{
+	if (FreezeActorClass)
+	{
+		OutClasses.AddUnique(FreezeActorClass);
+	}
+	if (ShrinkActorClass)
+	{
+		OutClasses.AddUnique(ShrinkActorClass);
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////
-// Freezing.
+// Status effects.
 
-void AShooterCharacter::Server_FreezePlayer(AShooterCharacter* DamagedCharacter)
+UShooterEffectOverlayCache* AShooterCharacter::GetEffectOverlayCache() const
 {
-	//If damanged character already has an active effect, do nothing.
-	if (DamagedCharacter->bIsAnyEffectActive_Server)
+	//Effect widgets are cached per local player, and reused for every hit.
+	APlayerController* PC = Cast<APlayerController>(Controller);
+	ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+	return LocalPlayer ? LocalPlayer->GetSubsystem<UShooterEffectOverlayCache>() : nullptr;
+}
+
+void AShooterCharacter::ReleaseEffectActor(AActor*& EffectActor) const
+{
+	UShooterEffectActorPool* EffectActorPool = GetWorld()->GetSubsystem<UShooterEffectActorPool>();
+	if (EffectActor && EffectActorPool)
 	{
-		return;
+		EffectActorPool->Release(EffectActor);
+	}
+	EffectActor = nullptr;
+}
+
+void AShooterCharacter::OnStatusEffectChanged(EShooterStatusEffect::Type Effect, bool bActive)
+{
+	//Server side, attach or release the effect actors. Timing is owned by the status effect component, so pooled actors have no lifespan.
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		if (Effect == EShooterStatusEffect::Freeze)
+		{
+			if (bActive)
+			{
+				FreezeActor = AcquireAttachedEffectActor(FreezeActorClass, this, 0.0f, FOnPooledEffectReleased());
+			}
+			else
+			{
+				ReleaseEffectActor(FreezeActor);
+			}
+		}
+		else if (Effect == EShooterStatusEffect::Shrink)
+		{
+			if (bActive)
+			{
+				ShrinkActor = AcquireAttachedEffectActor(ShrinkActorClass, this, 0.0f, FOnPooledEffectReleased());
+				SetTargetScale(ShrunkScale);
+				//Call the shrink event in blueprints.
+				Server_ShrinkEvent(this, false);
+			}
+			else
+			{
+				ReleaseEffectActor(ShrinkActor);
+				SetTargetScale(1.0f);
+				if (IsAlive())
+				{
+					//Call the shrink event in blueprints, and indicate we reverse the effect.
+					Server_ShrinkEvent(this, true);
+				}
+			}
+		}
+	}
+
+	//Shrunk state is kept on every machine. The scale itself follows TargetScalePercent in Tick.
+	if (Effect == EShooterStatusEffect::Shrink)
+	{
+		bShrunk = bActive;
+
+		//Dying pawns are torn off and go ragdoll, restore the full size right away on every machine.
+		if (!bActive && bIsDying)
+		{
+			TargetScalePercent = 100;
+			StartScalePercent = 100;
+			ApplyPawnScale(1.0f);
+		}
 	}
 
-	//Spawn the freeze actor.
-	FreezeActor = SpawnAndAttachActor(FreezeActorClass, DamagedCharacter, FreezeTime);
-	FreezeActor->OnDestroyed.AddDynamic(this, &AShooterCharacter::Server_FreezeActorDestroyed);
-	//Player currently frozen.
-	DamagedCharacter->bIsAnyEffectActive_Server = true;
+	//Local player side, input and widgets.
+	if (IsLocallyControlled() && Cast<AShooterPlayerController>(Controller))
+	{
+		if (Effect == EShooterStatusEffect::Freeze)
+		{
+			if (bActive)
+			{
+				FreezePlayer();
+			}
+			else
+			{
+				UnfreezePlayer();
+			}
+		}
+		else if (Effect == EShooterStatusEffect::Shrink)
+		{
+			if (bActive)
+			{
+				ShrinkPlayer();
+			}
+			else
+			{
+				UnshrinkPlayer();
+			}
+		}
+	}
 }
 
-//IDEA: add another parameter which is server only. And this way we have two params.
+//////////////////////////////////////////////////////////////////////////
+// Freezing.
 
 void AShooterCharacter::FreezePlayer()
 {
-	//If already have an active effect, do nothing.
-	if (bIsAnyEffectActive)
-	{
-		return;
-	}
-	
 	//Stop weapon fire (during tests observed some times weapon keeps firing).
 	StopWeaponFire();
 
 	//Disable input.
 	DisableInput(Cast<AShooterPlayerController>(Controller));
-	//Set effect active, we are frozen.
-	bIsAnyEffectActive = true;
-	//Add the freeze widget.
-	if (IsValid(FreezeWidgetClass))
+	//Show the freeze widget.
+	if (UShooterEffectOverlayCache* OverlayCache = GetEffectOverlayCache())
 	{
-		UUserWidget* FreezeWidget = CreateWidget<UUserWidget>(GetWorld(), FreezeWidgetClass);
-		FreezeWidget->AddToViewport();
+		OverlayCache->ShowOverlay(FreezeWidgetClass);
 	}
-	//Unfreeze after the given time.
-	FTimerHandle FreezeTimerHandle;
-	GetWorldTimerManager().SetTimer(FreezeTimerHandle, this, &AShooterCharacter::UnfreezePlayer, FreezeTime);
 }
 
 void AShooterCharacter::UnfreezePlayer()
 {
-	//Restore controlls and remove active effect.
+	//Restore controlls.
 	EnableInput(Cast<AShooterPlayerController>(Controller));
-	bIsAnyEffectActive = false;
-}
-
-void AShooterCharacter::Server_FreezeActorDestroyed(AActor* DestroyedActor) 
-{
-	//Get the player character which is being unfrozen. 
-	AShooterCharacter* PlayerCharacter = Cast<AShooterCharacter>(DestroyedActor->GetAttachParentActor());
-	//Player is no longer frozen, so no effects currently active.
-	PlayerCharacter->bIsAnyEffectActive_Server = false;
+	//Hide the freeze widget.
+	if (UShooterEffectOverlayCache* OverlayCache = GetEffectOverlayCache())
+	{
+		OverlayCache->HideOverlay(FreezeWidgetClass);
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////
 // Shrinking.
 
-void AShooterCharacter::Server_ShrinkPlayer(AShooterCharacter* DamagedCharacter)
+void AShooterCharacter::ShrinkPlayer()
 {
-	//If damanged character already has an active effect, do nothing.
-	if (DamagedCharacter->bIsAnyEffectActive_Server)
+	//Show the shrink widget.
+	if (UShooterEffectOverlayCache* OverlayCache = GetEffectOverlayCache())
 	{
-		return;
+		OverlayCache->ShowOverlay(ShrinkWidgetClass);
 	}
+}
 
-	//Spawn the shrink actor.
-	ShrinkActor = SpawnAndAttachActor(ShrinkActorClass, DamagedCharacter, ShrinkTime);
-	ShrinkActor->OnDestroyed.AddDynamic(this, &AShooterCharacter::Server_ShrinkActorDestroyed);
-	//Call the shrink event in blueprints.
-	Server_ShrinkEvent(DamagedCharacter, false);
-	//Player currently shrunk. Notice shrunk is not duplicated on client and server side, as it will not impact gameplay if its set twice to true/false.
-	DamagedCharacter->bShrunk = true;
-	DamagedCharacter->bIsAnyEffectActive_Server = true;
+void AShooterCharacter::UnshrinkPlayer()
+{
+	//Hide the shrink widget.
+	if (UShooterEffectOverlayCache* OverlayCache = GetEffectOverlayCache())
+	{
+		OverlayCache->HideOverlay(ShrinkWidgetClass);
+	}
 }
 
-void AShooterCharacter::ShrinkPlayer()
+void AShooterCharacter::SetTargetScale(float NewScale)
+{
+	StartScalePercent = (uint8)FMath::Clamp(FMath::RoundToInt(GetReplicatedScale() * 100.0f), 1, 255);
+	ScaleChangeTime = GetWorld()->GetTimeSeconds();
+	TargetScalePercent = (uint8)FMath::Clamp(FMath::RoundToInt(NewScale * 100.0f), 1, 255);
+}
+
+void AShooterCharacter::UpdatePawnScale(float DeltaSeconds)
+{
+	const float TargetScale = GetTargetScale();
+	if (CurrentScale != TargetScale)
+	{
+		ApplyPawnScale(FMath::FInterpConstantTo(CurrentScale, TargetScale, DeltaSeconds, ScaleInterpSpeed));
+	}
+}
+
+void AShooterCharacter::ApplyPawnScale(float NewScale)
 {
-	//If damanged character already has an active effect, do nothing.
-	if (bIsAnyEffectActive)
+	if (NewScale == CurrentScale)
 	{
 		return;
 	}
 
-	//Add the shrink widget to our viewport.
-	if (IsValid(ShrinkWidgetClass))
+	//Scaling the capsule scales it around its center, move the pawn so its feet stay on the ground.
+	UCapsuleComponent* Capsule = GetCapsuleComponent();
+	const float OldHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	CurrentScale = NewScale;
+	Capsule->SetWorldScale3D(FVector(NewScale));
+
+	//Simulated proxies get their location from replicated movement.
+	if (GetLocalRole() >= ROLE_AutonomousProxy)
 	{
-		UUserWidget* ShrinkWidget = CreateWidget<UUserWidget>(GetWorld(), ShrinkWidgetClass);
-		ShrinkWidget->AddToViewport();
+		const float HalfHeightDelta = Capsule->GetScaledCapsuleHalfHeight() - OldHalfHeight;
+		AddActorWorldOffset(FVector(0.0f, 0.0f, HalfHeightDelta), false, nullptr, ETeleportType::TeleportPhysics);
 	}
+}
 
-	//We are shrunk now.
-	bShrunk = true;
+float AShooterCharacter::GetReplicatedScale() const
+{
+	//Clients estimate the server time, so the server and the owning client agree on the scale while it changes.
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const float ServerTime = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
 
-	//Set effect active, we are shrunk.
-	bIsAnyEffectActive = true;
+	const float StartScale = StartScalePercent / 100.0f;
+	const float MaxDelta = FMath::Max(0.0f, ServerTime - ScaleChangeTime) * ScaleInterpSpeed;
+	return StartScale + FMath::Clamp(GetTargetScale() - StartScale, -MaxDelta, MaxDelta);
+}
 
-	//Unshrink after the given time.
-	FTimerHandle ShrinkTimerHandle;
-	GetWorldTimerManager().SetTimer(ShrinkTimerHandle, this, &AShooterCharacter::UnshrinkPlayer, ShrinkTime);
+float AShooterCharacter::GetScaleSpeedModifier() const
+{
+	const float Scale = GetReplicatedScale();
+	if (Scale >= 1.0f || ShrunkScale >= 1.0f)
+	{
+		return 1.0f;
+	}
+
+	const float ShrinkAlpha = FMath::Clamp((1.0f - Scale) / (1.0f - ShrunkScale), 0.0f, 1.0f);
+	return FMath::Lerp(1.0f, ShrunkSpeedModifier, ShrinkAlpha);
 }
 
-void AShooterCharacter::UnshrinkPlayer()
+void AShooterCharacter::EnterPawnPool()
 {
-	bIsAnyEffectActive = false;
-	bShrunk = false;
+	bInPawnPool = true;
+
+	// nothing of a pooled pawn ticks or collides until it respawns
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetComponentTickEnabled(false);
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		UShooterPawnPool* PawnPool = GetWorld()->GetSubsystem<UShooterPawnPool>();
+		if (PawnPool)
+		{
+			PawnPool->ReleasePawn(this);
+		}
+		else
+		{
+			Destroy();
+		}
+
+		// stop replicating the idle pawn, its channels send the hidden state before they go dormant
+		if (!IsPendingKillPending())
+		{
+			SetNetDormancy(DORM_DormantAll);
+		}
+	}
 }
 
-void AShooterCharacter::Server_ShrinkActorDestroyed(AActor* DestroyedActor)
+void AShooterCharacter::LeavePawnPool()
 {
-	//Get the player character which is being unshrunk. 
-	AShooterCharacter* PlayerCharacter = Cast<AShooterCharacter>(DestroyedActor->GetAttachParentActor());
-	//Player is no longer shrunk, so no effects currently active.
-	PlayerCharacter->bIsAnyEffectActive_Server = false;
-	PlayerCharacter->bShrunk = false;
+	check(GetLocalRole() == ROLE_Authority);
+
+	// wake up before changing replicated state so clients get the respawn
+	FlushNetDormancy();
+	SetNetDormancy(DORM_Awake);
 
-	if (PlayerCharacter->IsAlive())
+	Health = GetMaxHealth();
+	bReturnToPawnPool = false;
+	CurrentWeapon = nullptr;
+	RespawnCount++;
+	SetReplicatingMovement(true);
+
+	ResetPooledPawn();
+
+	// same as a new pawn, see PostInitializeComponents
+	GetWorldTimerManager().SetTimerForNextTick(this, &AShooterCharacter::SpawnDefaultInventory);
+	if (UShooterLagCompensation* LagCompensation = GetWorld()->GetSubsystem<UShooterLagCompensation>())
 	{
-		//Call the shrink event in blueprints, and indicate we reverse the effect.
-		Server_ShrinkEvent(PlayerCharacter, true);
+		LagCompensation->RegisterPawn(this);
 	}
-	else
+
+	PlayRespawnEffects();
+}
+
+void AShooterCharacter::OnRep_RespawnCount()
+{
+	// pawns this client sees for the first time are already alive
+	if (bIsDying || bInPawnPool)
 	{
-		Server_RestorePawnSize(PlayerCharacter);
+		ResetPooledPawn();
+		PlayRespawnEffects();
 	}
 }
 
-void AShooterCharacter::Server_RestorePawnSize_Implementation(AShooterCharacter* Target)
+/** copy collision settings of a component from the class defaults */
+static void RestoreDefaultCollision(UPrimitiveComponent* Component, const UPrimitiveComponent* DefaultComponent)
+{
+	Component->SetCollisionProfileName(DefaultComponent->GetCollisionProfileName());
+	Component->SetCollisionObjectType(DefaultComponent->GetCollisionObjectType());
+	Component->SetCollisionResponseToChannels(DefaultComponent->GetCollisionResponseToChannels());
+	Component->SetCollisionEnabled(DefaultComponent->GetCollisionEnabled());
+}
+
+void AShooterCharacter::ResetPooledPawn()
 {
-	//Raise player a bit else body will fall through floor.
-	FVector CurrentLocation = Target->GetTargetLocation();
-	CurrentLocation.Set(CurrentLocation.X, CurrentLocation.Y, CurrentLocation.Z + 50);
-	Target->SetActorLocation(CurrentLocation);
-	//Restore original scale.
-	Target->GetCapsuleComponent()->SetWorldScale3D(FVector(1.0f, 1.0f, 1.0f));
+	GetWorldTimerManager().ClearTimer(TimerHandle_EnterPawnPool);
+	bIsDying = false;
+	bInPawnPool = false;
+	bIsTargeting = false;
+	bWantsToRun = false;
+	bWantsToRunToggled = false;
+	bWantsToFire = false;
+	LastTakeHitInfo = FTakeHitInfo();
+	LastTakeHitTimeTimeout = 0.0f;
+
+	// effects ended on death, make sure the pawn is back to full size
+	StatusEffects->RemoveAllEffects();
+	TargetScalePercent = 100;
+	StartScalePercent = 100;
+	ApplyPawnScale(1.0f);
+
+	// put the mesh back on the capsule, the ragdoll moved it away
+	const AShooterCharacter* DefaultCharacter = GetClass()->GetDefaultObject<AShooterCharacter>();
+	USkeletalMeshComponent* CharacterMesh = GetMesh();
+	StopAllAnimMontages();
+	CharacterMesh->SetSimulatePhysics(false);
+	CharacterMesh->bBlendPhysics = DefaultCharacter->GetMesh()->bBlendPhysics;
+	CharacterMesh->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	CharacterMesh->SetRelativeLocationAndRotation(DefaultCharacter->GetMesh()->GetRelativeLocation(), DefaultCharacter->GetMesh()->GetRelativeRotation());
+	CharacterMesh->SetComponentTickEnabled(true);
+	RestoreDefaultCollision(CharacterMesh, DefaultCharacter->GetMesh());
+	RestoreDefaultCollision(GetCapsuleComponent(), DefaultCharacter->GetCapsuleComponent());
+
+	UCharacterMovementComponent* Movement = GetCharacterMovement();
+	Movement->StopMovementImmediately();
+	Movement->SetDefaultMovementMode();
+	Movement->SetComponentTickEnabled(true);
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	// team colors of the last owner, the new one sets them again once possessed
+	UpdatePawnMeshes();
+	UpdateTeamColorsAllMIDs();
 }
 
 //Pawn::PlayDying sets this lifespan, but when that function is called on client, dead pawn's role is still SimulatedProxy despite bTearOff being true. 
@@ -780,14 +1024,21 @@ void AShooterCharacter::SpawnDefaultInventory()
 		return;
 	}
 
+	AShooterPlayerState* MyPlayerState = GetPlayerState<AShooterPlayerState>();
+
 	int32 NumWeaponClasses = DefaultInventoryClasses.Num();
 	for (int32 i = 0; i < NumWeaponClasses; i++)
 	{
 		if (DefaultInventoryClasses[i])
 		{
-			FActorSpawnParameters SpawnInfo;
-			SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-			AShooterWeapon* NewWeapon = GetWorld()->SpawnActor<AShooterWeapon>(DefaultInventoryClasses[i], SpawnInfo);
+			// take the weapon back from the last life, spawn only if there is none
+			AShooterWeapon* NewWeapon = (MyPlayerState && KeepWeaponsOnRespawn) ? MyPlayerState->TakeStoredWeapon(DefaultInventoryClasses[i]) : nullptr;
+			if (NewWeapon == nullptr)
+			{
+				FActorSpawnParameters SpawnInfo;
+				SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+				NewWeapon = GetWorld()->SpawnActor<AShooterWeapon>(DefaultInventoryClasses[i], SpawnInfo);
+			}
 			AddWeapon(NewWeapon);
 		}
 	}
@@ -806,14 +1057,29 @@ void AShooterCharacter::DestroyInventory()
 		return;
 	}
 
-	// remove all weapons from inventory and destroy them
+	// remove all weapons from inventory, the player state keeps them for the next life
+	AShooterPlayerState* MyPlayerState = GetPlayerState<AShooterPlayerState>();
+	const bool bStoreWeapons = KeepWeaponsOnRespawn && MyPlayerState && !MyPlayerState->IsPendingKillPending();
+
 	for (int32 i = Inventory.Num() - 1; i >= 0; i--)
 	{
 		AShooterWeapon* Weapon = Inventory[i];
 		if (Weapon)
 		{
 			RemoveWeapon(Weapon);
-			Weapon->Destroy();
+			if (bStoreWeapons)
+			{
+				MyPlayerState->StoreWeapon(Weapon);
+			}
+			else
+			{
+				// weapons taken from the player state but never equipped still replicate with it
+				if (MyPlayerState)
+				{
+					AShooterPlayerState::NotifyReleaseWeapon.Broadcast(MyPlayerState, Weapon);
+				}
+				Weapon->Destroy();
+			}
 		}
 	}
 }
@@ -1292,6 +1558,8 @@ void AShooterCharacter::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
+	UpdatePawnScale(DeltaSeconds);
+
 	if (bWantsToRunToggled && !IsRunning())
 	{
 		SetRunning(false, false);
@@ -1413,6 +1681,11 @@ void AShooterCharacter::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > &
 	// everyone
 	DOREPLIFETIME(AShooterCharacter, CurrentWeapon);
 	DOREPLIFETIME(AShooterCharacter, Health);
+	DOREPLIFETIME(AShooterCharacter, TargetScalePercent);
+	DOREPLIFETIME(AShooterCharacter, StartScalePercent);
+	DOREPLIFETIME(AShooterCharacter, ScaleChangeTime);
+	DOREPLIFETIME(AShooterCharacter, bReturnToPawnPool);
+	DOREPLIFETIME(AShooterCharacter, RespawnCount);
 }
 
 bool AShooterCharacter::IsReplicationPausedForConnection(const FNetViewer& ConnectionOwnerNetViewer)
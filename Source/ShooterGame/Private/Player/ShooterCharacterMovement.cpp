@@ -27,6 +27,7 @@ float UShooterCharacterMovement::GetMaxSpeed() const
 		{
 			MaxSpeed *= ShooterCharacterOwner->GetRunningSpeedModifier();
 		}
+		MaxSpeed *= ShooterCharacterOwner->GetScaleSpeedModifier();
 	}
 
 	return MaxSpeed;
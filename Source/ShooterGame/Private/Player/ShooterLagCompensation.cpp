@@ -0,0 +1,183 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterLagCompensation.h"
+
+DECLARE_CYCLE_STAT(TEXT("Record Hitbox History"), STAT_ShooterRecordHitboxes, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Lag Compensated Pawns"), STAT_ShooterLagCompensatedPawns, STATGROUP_ShooterGame);
+
+static float MaxLagCompensation = 0.4f;
+FAutoConsoleVariableRef CVarMaxLagCompensation(
+	TEXT("ShooterGame.MaxLagCompensation"),
+	MaxLagCompensation,
+	TEXT("How far back in seconds client hits can be rewound."),
+	ECVF_Default);
+
+static_assert((FShooterHitboxHistory::NumSamples & (FShooterHitboxHistory::NumSamples - 1)) == 0, "NumSamples must be a power of two");
+
+void FShooterHitboxHistory::Add(float Time, const FVector& Center, const FVector& Extent)
+{
+	Head = (Head + 1) & (NumSamples - 1);
+	Times[Head] = Time;
+	Centers[Head] = Center;
+	Extents[Head] = Extent;
+	Num = FMath::Min(Num + 1, NumSamples);
+}
+
+bool FShooterHitboxHistory::GetAtTime(float Time, FVector& OutCenter, FVector& OutExtent) const
+{
+	if (Num == 0)
+	{
+		return false;
+	}
+
+	const int32 Newest = GetIndex(0);
+	const int32 Oldest = GetIndex(Num - 1);
+	if (Time >= Times[Newest] || Num == 1)
+	{
+		OutCenter = Centers[Newest];
+		OutExtent = Extents[Newest];
+		return true;
+	}
+	if (Time <= Times[Oldest])
+	{
+		OutCenter = Centers[Oldest];
+		OutExtent = Extents[Oldest];
+		return true;
+	}
+
+	// binary search on age: find the youngest sample not newer than Time
+	int32 Low = 1;
+	int32 High = Num - 1;
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (Times[GetIndex(Mid)] <= Time)
+		{
+			High = Mid;
+		}
+		else
+		{
+			Low = Mid + 1;
+		}
+	}
+
+	const int32 Before = GetIndex(Low);
+	const int32 After = GetIndex(Low - 1);
+	const float Span = Times[After] - Times[Before];
+	const float Alpha = Span > KINDA_SMALL_NUMBER ? (Time - Times[Before]) / Span : 1.0f;
+	OutCenter = FMath::Lerp(Centers[Before], Centers[After], Alpha);
+	OutExtent = FMath::Lerp(Extents[Before], Extents[After], Alpha);
+	return true;
+}
+
+bool UShooterLagCompensation::ShouldCreateSubsystem(UObject* Outer) const
+{
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UShooterLagCompensation::RegisterPawn(AShooterCharacter* Pawn)
+{
+	if (Pawn && !PawnIndices.Contains(Pawn))
+	{
+		PawnIndices.Add(Pawn, Pawns.Num());
+		Pawns.Add(Pawn);
+		Histories.AddDefaulted();
+		INC_DWORD_STAT(STAT_ShooterLagCompensatedPawns);
+	}
+}
+
+void UShooterLagCompensation::UnregisterPawn(AShooterCharacter* Pawn)
+{
+	if (const int32* Index = PawnIndices.Find(Pawn))
+	{
+		RemoveAt(*Index);
+	}
+}
+
+bool UShooterLagCompensation::GetHitboxAtTime(const AShooterCharacter* Pawn, float Time, FVector& OutCenter, FVector& OutExtent) const
+{
+	const int32* Index = PawnIndices.Find(Pawn);
+	if (Index == nullptr)
+	{
+		return false;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	const float RewindTime = FMath::Clamp(Time, Now - MaxLagCompensation, Now);
+	return Histories[*Index].GetAtTime(RewindTime, OutCenter, OutExtent);
+}
+
+float UShooterLagCompensation::GetClientFireTime(const UWorld* World)
+{
+	const AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	return GameState ? GameState->GetServerWorldTimeSeconds() : (World ? World->GetTimeSeconds() : 0.0f);
+}
+
+void UShooterLagCompensation::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterRecordHitboxes);
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	for (int32 Index = Pawns.Num() - 1; Index >= 0; Index--)
+	{
+		const AShooterCharacter* Pawn = Pawns[Index].Get();
+		if (Pawn == nullptr)
+		{
+			RemoveAt(Index);
+			continue;
+		}
+
+		const UCapsuleComponent* Capsule = Pawn->GetCapsuleComponent();
+		const float Radius = Capsule->GetScaledCapsuleRadius();
+		Histories[Index].Add(Now, Capsule->GetComponentLocation(), FVector(Radius, Radius, Capsule->GetScaledCapsuleHalfHeight()));
+	}
+}
+
+bool UShooterLagCompensation::IsTickable() const
+{
+	// only servers get hits from remote clients
+	const UWorld* World = GetWorld();
+	return Pawns.Num() > 0 && World && World->GetNetMode() != NM_Standalone && World->GetNetMode() != NM_Client && !IsTemplate();
+}
+
+TStatId UShooterLagCompensation::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterLagCompensation, STATGROUP_Tickables);
+}
+
+UWorld* UShooterLagCompensation::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterLagCompensation::RemoveAt(int32 Index)
+{
+	// PawnIndices may hold a stale key for destroyed pawns, find it by index
+	for (auto It = PawnIndices.CreateIterator(); It; ++It)
+	{
+		if (It.Value() == Index)
+		{
+			It.RemoveCurrent();
+			break;
+		}
+	}
+
+	const int32 LastIndex = Pawns.Num() - 1;
+	if (Index != LastIndex)
+	{
+		for (auto& It : PawnIndices)
+		{
+			if (It.Value == LastIndex)
+			{
+				It.Value = Index;
+				break;
+			}
+		}
+	}
+
+	Pawns.RemoveAtSwap(Index, 1, false);
+	Histories.RemoveAtSwap(Index, 1, false);
+	DEC_DWORD_STAT(STAT_ShooterLagCompensatedPawns);
+}
@@ -0,0 +1,144 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterPawnPool.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pawn Pool Hits"), STAT_ShooterPawnPoolHits, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pawn Pool Misses"), STAT_ShooterPawnPoolMisses, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pawns Pooled"), STAT_ShooterPawnPoolSize, STATGROUP_ShooterGame);
+
+static int32 PawnPooling = 1;
+FAutoConsoleVariableRef CVarPawnPooling(
+	TEXT("ShooterGame.PawnPooling"),
+	PawnPooling,
+	TEXT("Recycle dead pawns for respawns instead of destroying them after the ragdoll.\n")
+	TEXT("0: tear off and destroy dead pawns, 1: pool them"),
+	ECVF_Default);
+
+static int32 MaxPooledPawns = 32;
+FAutoConsoleVariableRef CVarMaxPooledPawns(
+	TEXT("ShooterGame.MaxPooledPawns"),
+	MaxPooledPawns,
+	TEXT("Dead pawns kept for respawns, over all pawn classes. Pawns released to a full pool are destroyed."),
+	ECVF_Default);
+
+static float PooledRagdollTime = 10.0f;
+FAutoConsoleVariableRef CVarPooledRagdollTime(
+	TEXT("ShooterGame.PooledRagdollTime"),
+	PooledRagdollTime,
+	TEXT("Seconds a dead pooled pawn ragdolls before it's hidden and can be respawned.\n")
+	TEXT("Respawns that come sooner spawn a new pawn, the dead one still goes back to the pool afterwards."),
+	ECVF_Default);
+
+bool UShooterPawnPool::ShouldCreateSubsystem(UObject* Outer) const
+{
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UShooterPawnPool::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_ShooterPawnPoolSize, NumPooled);
+
+	// pawns are owned by the level and go away with it
+	FreePawns.Empty();
+	NumPooled = 0;
+
+	Super::Deinitialize();
+}
+
+bool UShooterPawnPool::IsPoolingEnabled()
+{
+	return PawnPooling != 0;
+}
+
+float UShooterPawnPool::GetRagdollTime()
+{
+	return FMath::Max(0.1f, PooledRagdollTime);
+}
+
+AShooterCharacter* UShooterPawnPool::AcquirePawn(UClass* PawnClass, const FTransform& SpawnTransform)
+{
+	FShooterPooledPawns* Pool = PawnClass ? FreePawns.Find(PawnClass) : nullptr;
+	if (Pool == nullptr)
+	{
+		return nullptr;
+	}
+
+	AShooterCharacter* Pawn = nullptr;
+	while (Pool->Pawns.Num() > 0 && Pawn == nullptr)
+	{
+		AShooterCharacter* Candidate = Pool->Pawns.Pop(false);
+		NumPooled--;
+		DEC_DWORD_STAT(STAT_ShooterPawnPoolSize);
+
+		if (IsValid(Candidate))
+		{
+			Pawn = Candidate;
+		}
+	}
+
+	if (Pawn)
+	{
+		NumHits++;
+		INC_DWORD_STAT(STAT_ShooterPawnPoolHits);
+
+		Pawn->SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, nullptr, ETeleportType::TeleportPhysics);
+		Pawn->LeavePawnPool();
+	}
+	return Pawn;
+}
+
+void UShooterPawnPool::ReleasePawn(AShooterCharacter* Pawn)
+{
+	if (!IsValid(Pawn))
+	{
+		return;
+	}
+
+	if (NumPooled >= MaxPooledPawns)
+	{
+		// pooled pawns may have been destroyed by a level reset, drop those first
+		for (auto& It : FreePawns)
+		{
+			const int32 NumRemoved = It.Value.Pawns.RemoveAll([](const AShooterCharacter* PooledPawn) { return !IsValid(PooledPawn); });
+			NumPooled -= NumRemoved;
+			DEC_DWORD_STAT_BY(STAT_ShooterPawnPoolSize, NumRemoved);
+		}
+
+		if (NumPooled >= MaxPooledPawns)
+		{
+			Pawn->Destroy();
+			return;
+		}
+	}
+
+	FreePawns.FindOrAdd(Pawn->GetClass()).Pawns.Add(Pawn);
+	NumPooled++;
+	INC_DWORD_STAT(STAT_ShooterPawnPoolSize);
+}
+
+void UShooterPawnPool::NotifyPawnSpawned()
+{
+	NumMisses++;
+	INC_DWORD_STAT(STAT_ShooterPawnPoolMisses);
+}
+
+void UShooterPawnPool::DumpStats() const
+{
+	UE_LOG(LogShooter, Log, TEXT("Pawn pool: %d hits, %d misses, %d idle of %d"), NumHits, NumMisses, NumPooled, MaxPooledPawns);
+	for (const auto& It : FreePawns)
+	{
+		UE_LOG(LogShooter, Log, TEXT("  %s: %d idle"), *GetNameSafe(It.Key), It.Value.Pawns.Num());
+	}
+}
+
+FAutoConsoleCommandWithWorld ShooterDumpPawnPoolCmd(TEXT("ShooterGame.DumpPawnPool"), TEXT("Prints pawn pool hits, misses and idle pawns"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UShooterPawnPool* Pool = World ? World->GetSubsystem<UShooterPawnPool>() : nullptr)
+		{
+			Pool->DumpStats();
+		}
+	})
+);
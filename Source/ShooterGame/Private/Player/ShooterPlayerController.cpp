@@ -904,6 +904,15 @@ void AShooterPlayerController::ClientSendRoundEndEvent_Implementation(bool bIsWi
 	}
 }
 
+void AShooterPlayerController::ClientReceiveWeaponStats_Implementation(const TArray<FName>& RowNames, const TArray<FShooterWeaponStatsRow>& Rows)
+{
+	UShooterWeaponStats* WeaponStats = GetWorld()->GetSubsystem<UShooterWeaponStats>();
+	if (WeaponStats)
+	{
+		WeaponStats->ReceiveStats(RowNames, Rows);
+	}
+}
+
 void AShooterPlayerController::SetCinematicMode(bool bInCinematicMode, bool bHidePlayer, bool bAffectsHUD, bool bAffectsMovement, bool bAffectsTurning)
 {
 	Super::SetCinematicMode(bInCinematicMode, bHidePlayer, bAffectsHUD, bAffectsMovement, bAffectsTurning);
@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterStatusEffectComponent.h"
+#include "Player/ShooterStatusEffectScheduler.h"
+
+bool FShooterStatusEffectState::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	// mask first, then expiry only for active effects
+	Ar.SerializeBits(&ActiveMask, EShooterStatusEffect::MAX);
+	for (int32 EffectIdx = 0; EffectIdx < EShooterStatusEffect::MAX; EffectIdx++)
+	{
+		if (IsActive((EShooterStatusEffect::Type)EffectIdx))
+		{
+			Ar << ExpiryTime[EffectIdx];
+		}
+		else if (Ar.IsLoading())
+		{
+			ExpiryTime[EffectIdx] = 0;
+		}
+	}
+
+	bOutSuccess = true;
+	return true;
+}
+
+bool FShooterStatusEffectState::operator==(const FShooterStatusEffectState& Other) const
+{
+	if (ActiveMask != Other.ActiveMask)
+	{
+		return false;
+	}
+
+	for (int32 EffectIdx = 0; EffectIdx < EShooterStatusEffect::MAX; EffectIdx++)
+	{
+		if (IsActive((EShooterStatusEffect::Type)EffectIdx) && ExpiryTime[EffectIdx] != Other.ExpiryTime[EffectIdx])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+UShooterStatusEffectComponent::UShooterStatusEffectComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	SetIsReplicatedByDefault(true);
+
+	NotifiedMask = 0;
+}
+
+bool UShooterStatusEffectComponent::ApplyEffect(EShooterStatusEffect::Type Effect, float Duration)
+{
+	// only one effect at a time
+	if (GetOwnerRole() != ROLE_Authority || IsAnyEffectActive() || Duration <= 0.0f)
+	{
+		return false;
+	}
+
+	UShooterStatusEffectScheduler* Scheduler = GetWorld()->GetSubsystem<UShooterStatusEffectScheduler>();
+	if (Scheduler == nullptr)
+	{
+		return false;
+	}
+
+	const float ExpireTime = GetServerTime() + Duration;
+	State.ExpiryTime[Effect] = FShooterStatusEffectState::QuantizeTime(ExpireTime);
+	ExpiryHandles[Effect] = Scheduler->ScheduleExpiry(this, Effect, ExpireTime);
+	SetActiveMask(State.ActiveMask | (1 << Effect));
+	return true;
+}
+
+void UShooterStatusEffectComponent::RemoveEffect(EShooterStatusEffect::Type Effect)
+{
+	if (GetOwnerRole() == ROLE_Authority && HasEffect(Effect))
+	{
+		const uint8 NewMask = State.ActiveMask & ~(1 << Effect);
+		CancelExpiries(NewMask);
+		SetActiveMask(NewMask);
+	}
+}
+
+void UShooterStatusEffectComponent::RemoveAllEffects()
+{
+	if (IsAnyEffectActive() || NotifiedMask != 0)
+	{
+		CancelExpiries(0);
+		SetActiveMask(0);
+	}
+}
+
+void UShooterStatusEffectComponent::OnEffectExpired(EShooterStatusEffect::Type Effect)
+{
+	ExpiryHandles[Effect].Invalidate();
+	if (HasEffect(Effect))
+	{
+		SetActiveMask(State.ActiveMask & ~(1 << Effect));
+	}
+}
+
+void UShooterStatusEffectComponent::OnUnregister()
+{
+	CancelExpiries(0);
+	Super::OnUnregister();
+}
+
+void UShooterStatusEffectComponent::CancelExpiries(uint8 KeepMask)
+{
+	UWorld* World = GetWorld();
+	UShooterStatusEffectScheduler* Scheduler = World ? World->GetSubsystem<UShooterStatusEffectScheduler>() : nullptr;
+	for (int32 EffectIdx = 0; EffectIdx < EShooterStatusEffect::MAX; EffectIdx++)
+	{
+		if (ExpiryHandles[EffectIdx].IsSet() && !(KeepMask & (1 << EffectIdx)))
+		{
+			if (Scheduler)
+			{
+				Scheduler->CancelExpiry(ExpiryHandles[EffectIdx]);
+			}
+			ExpiryHandles[EffectIdx].Invalidate();
+		}
+	}
+}
+
+float UShooterStatusEffectComponent::GetRemainingTime(EShooterStatusEffect::Type Effect) const
+{
+	if (!HasEffect(Effect))
+	{
+		return 0.0f;
+	}
+
+	return FMath::Max(0.0f, FShooterStatusEffectState::GetTimeUntil(State.ExpiryTime[Effect], GetServerTime()));
+}
+
+void UShooterStatusEffectComponent::OnRep_State()
+{
+	SetActiveMask(State.ActiveMask);
+}
+
+float UShooterStatusEffectComponent::GetServerTime() const
+{
+	UWorld* World = GetWorld();
+	AGameStateBase* const GameState = World ? World->GetGameState() : nullptr;
+	return GameState ? GameState->GetServerWorldTimeSeconds() : (World ? World->GetTimeSeconds() : 0.0f);
+}
+
+void UShooterStatusEffectComponent::SetActiveMask(uint8 NewMask)
+{
+	State.ActiveMask = NewMask;
+
+	const uint8 ChangedMask = NotifiedMask ^ NewMask;
+	NotifiedMask = NewMask;
+
+	// endings first, so a new effect replicated together with the end of the old one starts from a clean state
+	for (int32 EffectIdx = 0; EffectIdx < EShooterStatusEffect::MAX; EffectIdx++)
+	{
+		if ((ChangedMask & (1 << EffectIdx)) && !(NewMask & (1 << EffectIdx)))
+		{
+			OnEffectChanged.Broadcast((EShooterStatusEffect::Type)EffectIdx, false);
+		}
+	}
+	for (int32 EffectIdx = 0; EffectIdx < EShooterStatusEffect::MAX; EffectIdx++)
+	{
+		if ((ChangedMask & (1 << EffectIdx)) && (NewMask & (1 << EffectIdx)))
+		{
+			OnEffectChanged.Broadcast((EShooterStatusEffect::Type)EffectIdx, true);
+		}
+	}
+}
+
+void UShooterStatusEffectComponent::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UShooterStatusEffectComponent, State);
+}
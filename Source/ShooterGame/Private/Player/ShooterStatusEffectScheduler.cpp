@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterStatusEffectScheduler.h"
+#include "Player/ShooterStatusEffectComponent.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Status Effect Expirations"), STAT_ShooterStatusEffectExpirations, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Status Effects Pending"), STAT_ShooterStatusEffectsPending, STATGROUP_ShooterGame);
+
+bool UShooterStatusEffectScheduler::ShouldCreateSubsystem(UObject* Outer) const
+{
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+FShooterTimingWheelHandle UShooterStatusEffectScheduler::ScheduleExpiry(UShooterStatusEffectComponent* Component, EShooterStatusEffect::Type Effect, float ExpireTime)
+{
+	// idle wheel doesn't advance, catch up before inserting relative to it
+	const uint64 NowStep = GetStepForTime(GetWorld()->GetTimeSeconds());
+	if (Wheel.Num() == 0)
+	{
+		Wheel.Reset(NowStep);
+	}
+
+	FShooterStatusEffectExpiry Expiry;
+	Expiry.Component = Component;
+	Expiry.Effect = Effect;
+
+	INC_DWORD_STAT(STAT_ShooterStatusEffectsPending);
+	return Wheel.Schedule((uint64)FMath::Max(0, FMath::CeilToInt(ExpireTime * FShooterStatusEffectState::TimeStepsPerSecond)), Expiry);
+}
+
+void UShooterStatusEffectScheduler::CancelExpiry(FShooterTimingWheelHandle& Handle)
+{
+	if (Wheel.Cancel(Handle))
+	{
+		DEC_DWORD_STAT(STAT_ShooterStatusEffectsPending);
+	}
+}
+
+void UShooterStatusEffectScheduler::Tick(float DeltaTime)
+{
+	ExpiredThisFrame.Reset();
+	Wheel.Advance(GetStepForTime(GetWorld()->GetTimeSeconds()), ExpiredThisFrame);
+
+	if (ExpiredThisFrame.Num() > 0)
+	{
+		INC_DWORD_STAT_BY(STAT_ShooterStatusEffectExpirations, ExpiredThisFrame.Num());
+		DEC_DWORD_STAT_BY(STAT_ShooterStatusEffectsPending, ExpiredThisFrame.Num());
+
+		for (const FShooterStatusEffectExpiry& Expiry : ExpiredThisFrame)
+		{
+			if (UShooterStatusEffectComponent* Component = Expiry.Component.Get())
+			{
+				Component->OnEffectExpired(Expiry.Effect);
+			}
+		}
+	}
+}
+
+bool UShooterStatusEffectScheduler::IsTickable() const
+{
+	return Wheel.Num() > 0 && !IsTemplate();
+}
+
+TStatId UShooterStatusEffectScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterStatusEffectScheduler, STATGROUP_Tickables);
+}
+
+UWorld* UShooterStatusEffectScheduler::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+uint64 UShooterStatusEffectScheduler::GetStepForTime(float TimeSeconds)
+{
+	return (uint64)FMath::Max(0, FMath::FloorToInt(TimeSeconds * FShooterStatusEffectState::TimeStepsPerSecond));
+}
@@ -0,0 +1,173 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "Tests/ShooterTestControllerBotFreezeBenchmark.h"
+#include "ShooterGame.h"
+#include "Bots/ShooterAIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+
+void UShooterTestControllerBotFreezeBenchmark::OnInit()
+{
+	if (!FParse::Value(FCommandLine::Get(), TEXT("BenchmarkBots="), NumBots))
+	{
+		NumBots = 16;
+	}
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("BenchmarkIterations="), NumIterations))
+	{
+		NumIterations = 20;
+	}
+
+	WaitStartTime = 0.0;
+}
+
+void UShooterTestControllerBotFreezeBenchmark::OnTick(float TimeDelta)
+{
+	UWorld* World = GetWorld();
+	AShooterGameMode* GameMode = World ? World->GetAuthGameMode<AShooterGameMode>() : nullptr;
+	if (GameMode == nullptr || !GameMode->IsMatchInProgress())
+	{
+		return;
+	}
+
+	if (WaitStartTime == 0.0)
+	{
+		WaitStartTime = FPlatformTime::Seconds();
+	}
+
+	TArray<AShooterAIController*> Bots;
+	GatherBots(Bots);
+	if (Bots.Num() < NumBots && FPlatformTime::Seconds() - WaitStartTime < MaxWaitTime)
+	{
+		return;
+	}
+
+	if (Bots.Num() == 0)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Bot freeze benchmark: no bots in the match, add ?Bots=N to the map URL"));
+		EndTest(1);
+		return;
+	}
+
+	// unpossessing clears the blackboard, so each approach gets its own half of the bots
+	TArray<AShooterAIController*> RepossessBots;
+	TArray<AShooterAIController*> SuspendBots;
+	for (int32 i = 0; i < Bots.Num(); i++)
+	{
+		(i % 2 == 0 ? RepossessBots : SuspendBots).Add(Bots[i]);
+	}
+
+	const FPassResult Repossess = RunPass(RepossessBots, false);
+	const FPassResult Suspend = RunPass(SuspendBots, true);
+
+	UE_LOG(LogGauntlet, Display, TEXT("Bot freeze benchmark: %d cycles, blackboards compared right after the last unfreeze"), NumIterations);
+	UE_LOG(LogGauntlet, Display, TEXT("  unpossess/possess: %d bots, %.2f us per bot, %d bots changed, %d of %d keys changed"),
+		Repossess.NumBots, Repossess.Time, Repossess.NumBotsChanged, Repossess.NumKeysChanged, Repossess.NumKeys);
+	UE_LOG(LogGauntlet, Display, TEXT("  suspend/resume:    %d bots, %.2f us per bot, %d bots changed, %d of %d keys changed"),
+		Suspend.NumBots, Suspend.Time, Suspend.NumBotsChanged, Suspend.NumKeysChanged, Suspend.NumKeys);
+
+	// suspending is meant to keep the blackboard as it was
+	if (Suspend.NumBotsChanged > 0)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Bot freeze benchmark: %d suspended bots lost blackboard state"), Suspend.NumBotsChanged);
+		EndTest(1);
+		return;
+	}
+
+	EndTest(0);
+}
+
+UShooterTestControllerBotFreezeBenchmark::FPassResult UShooterTestControllerBotFreezeBenchmark::RunPass(const TArray<AShooterAIController*>& Bots, bool bSuspend) const
+{
+	FPassResult Result;
+	Result.NumBots = Bots.Num();
+
+	TArray<TArray<FString>> ValuesBefore;
+	ValuesBefore.SetNum(Bots.Num());
+	for (int32 BotIdx = 0; BotIdx < Bots.Num(); BotIdx++)
+	{
+		SnapshotBlackboard(Bots[BotIdx], ValuesBefore[BotIdx]);
+	}
+
+	double TotalTime = 0.0;
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		for (AShooterAIController* Bot : Bots)
+		{
+			APawn* BotPawn = Bot->GetPawn();
+			if (BotPawn == nullptr)
+			{
+				continue;
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			if (bSuspend)
+			{
+				Bot->SetSuspended(true);
+				Bot->SetSuspended(false);
+			}
+			else
+			{
+				Bot->StopMovement();
+				Bot->UnPossess();
+				Bot->Possess(BotPawn);
+			}
+			TotalTime += FPlatformTime::Seconds() - StartTime;
+		}
+	}
+
+	const int32 NumCycles = FMath::Max(1, Bots.Num() * NumIterations);
+	Result.Time = TotalTime * 1000000.0 / NumCycles;
+
+	// the passes run within one frame, nothing but the freeze itself touched the blackboards
+	for (int32 BotIdx = 0; BotIdx < Bots.Num(); BotIdx++)
+	{
+		TArray<FString> ValuesAfter;
+		SnapshotBlackboard(Bots[BotIdx], ValuesAfter);
+
+		bool bChanged = ValuesAfter.Num() != ValuesBefore[BotIdx].Num();
+		for (int32 KeyIdx = 0; KeyIdx < ValuesBefore[BotIdx].Num(); KeyIdx++)
+		{
+			Result.NumKeys++;
+			if (!ValuesAfter.IsValidIndex(KeyIdx) || ValuesAfter[KeyIdx] != ValuesBefore[BotIdx][KeyIdx])
+			{
+				Result.NumKeysChanged++;
+				bChanged = true;
+			}
+		}
+
+		if (bChanged)
+		{
+			Result.NumBotsChanged++;
+		}
+	}
+
+	return Result;
+}
+
+void UShooterTestControllerBotFreezeBenchmark::SnapshotBlackboard(AShooterAIController* Bot, TArray<FString>& OutValues)
+{
+	OutValues.Reset();
+
+	UBlackboardComponent* Blackboard = Bot->GetBlackboardComp();
+	if (Blackboard == nullptr || Blackboard->GetBlackboardAsset() == nullptr)
+	{
+		return;
+	}
+
+	for (int32 KeyIdx = 0; KeyIdx < Blackboard->GetNumKeys(); KeyIdx++)
+	{
+		const FBlackboard::FKey KeyID = static_cast<FBlackboard::FKey>(KeyIdx);
+		OutValues.Add(Blackboard->DescribeKeyValue(KeyID, EBlackboardDescription::OnlyValue));
+	}
+}
+
+void UShooterTestControllerBotFreezeBenchmark::GatherBots(TArray<AShooterAIController*>& OutBots) const
+{
+	for (AShooterAIController* Bot : TActorRange<AShooterAIController>(GetWorld()))
+	{
+		AShooterCharacter* BotPawn = Cast<AShooterCharacter>(Bot->GetPawn());
+		if (BotPawn && BotPawn->IsAlive())
+		{
+			OutBots.Add(Bot);
+		}
+	}
+}
@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "Tests/ShooterTestControllerLastShotTest.h"
+#include "ShooterGame.h"
+#include "Weapons/ShooterWeapon_Instant.h"
+
+void UShooterTestControllerLastShotTest::OnInit()
+{
+	WaitStartTime = 0.0;
+}
+
+void UShooterTestControllerLastShotTest::OnTick(float TimeDelta)
+{
+	if (WaitStartTime == 0.0)
+	{
+		WaitStartTime = FPlatformTime::Seconds();
+	}
+
+	UWorld* World = GetWorld();
+	APlayerController* PC = (World && World->GetNetMode() == NM_Client) ? World->GetFirstPlayerController() : nullptr;
+	AShooterCharacter* Pawn = PC ? Cast<AShooterCharacter>(PC->GetPawn()) : nullptr;
+	AShooterWeapon_Instant* Weapon = Pawn ? Cast<AShooterWeapon_Instant>(Pawn->GetWeapon()) : nullptr;
+	if (Weapon == nullptr || Weapon->GetCurrentState() != EWeaponState::Idle || Weapon->GetCurrentAmmoInClip() <= 0)
+	{
+		if (FPlatformTime::Seconds() - WaitStartTime > MaxWaitTime)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Last shot test: no client pawn with a loaded instant hit weapon after %.0f secs"), MaxWaitTime);
+			EndTest(-1);
+		}
+		return;
+	}
+
+	const int32 AmmoBefore = Weapon->GetCurrentAmmoInClip();
+	Weapon->StartFire();
+	const int32 NumShots = AmmoBefore - Weapon->GetCurrentAmmoInClip();
+	Weapon->StopFire();
+	const int32 NumUnsent = Weapon->GetNumUnsentShots();
+
+	if (NumShots != 1)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Last shot test: %s fired %d shots instead of 1"), *Weapon->GetName(), NumShots);
+		EndTest(-1);
+	}
+	else if (NumUnsent > 0)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Last shot test: %d shots of %s not sent to the server before ServerStopFire"), NumUnsent, *Weapon->GetName());
+		EndTest(-1);
+	}
+	else
+	{
+		UE_LOG(LogGauntlet, Display, TEXT("Last shot test: shot of %s sent before ServerStopFire"), *Weapon->GetName());
+		EndTest(0);
+	}
+}
@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "UI/ShooterEffectOverlayCache.h"
+#include "Blueprint/UserWidget.h"
+#include "Animation/WidgetAnimation.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Effect Overlay Widgets"), STAT_ShooterEffectOverlayWidgets, STATGROUP_ShooterGame);
+
+void UShooterEffectOverlayCache::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	OnWorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &UShooterEffectOverlayCache::OnWorldCleanup);
+}
+
+void UShooterEffectOverlayCache::Deinitialize()
+{
+	FWorldDelegates::OnWorldCleanup.Remove(OnWorldCleanupHandle);
+	ClearOverlays();
+
+	Super::Deinitialize();
+}
+
+UUserWidget* UShooterEffectOverlayCache::ShowOverlay(TSubclassOf<UUserWidget> WidgetClass)
+{
+	if (WidgetClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	FShooterEffectOverlay* Overlay = Overlays.Find(WidgetClass);
+	if (Overlay == nullptr || !IsValid(Overlay->Widget))
+	{
+		ULocalPlayer* LocalPlayer = GetLocalPlayer();
+		APlayerController* PC = LocalPlayer ? LocalPlayer->GetPlayerController(LocalPlayer->GetWorld()) : nullptr;
+		UUserWidget* NewWidget = PC ? CreateWidget<UUserWidget>(PC, WidgetClass) : nullptr;
+		if (NewWidget == nullptr)
+		{
+			return nullptr;
+		}
+
+		if (Overlay == nullptr)
+		{
+			INC_DWORD_STAT(STAT_ShooterEffectOverlayWidgets);
+			Overlay = &Overlays.Add(WidgetClass);
+		}
+		Overlay->Widget = NewWidget;
+		Overlay->ShownVisibility = NewWidget->GetVisibility();
+		Overlay->Animations.Reset();
+
+		// animations are exposed as properties of the generated widget class
+		for (TFieldIterator<FObjectProperty> PropIt(WidgetClass); PropIt; ++PropIt)
+		{
+			if (PropIt->PropertyClass && PropIt->PropertyClass->IsChildOf(UWidgetAnimation::StaticClass()))
+			{
+				if (UWidgetAnimation* Animation = Cast<UWidgetAnimation>(PropIt->GetObjectPropertyValue_InContainer(NewWidget)))
+				{
+					Overlay->Animations.Add(Animation);
+				}
+			}
+		}
+	}
+
+	UUserWidget* Widget = Overlay->Widget;
+
+	// widget blueprints may remove themselves once their animation is done
+	if (!Widget->IsInViewport())
+	{
+		Widget->AddToViewport();
+	}
+	Widget->SetVisibility(Overlay->ShownVisibility);
+
+	for (UWidgetAnimation* Animation : Overlay->Animations)
+	{
+		Widget->PlayAnimation(Animation, 0.0f, 1, EUMGSequencePlayMode::Forward, 1.0f, true);
+	}
+
+	return Widget;
+}
+
+void UShooterEffectOverlayCache::HideOverlay(TSubclassOf<UUserWidget> WidgetClass)
+{
+	FShooterEffectOverlay* Overlay = WidgetClass ? Overlays.Find(WidgetClass) : nullptr;
+	if (Overlay && IsValid(Overlay->Widget))
+	{
+		Overlay->Widget->StopAllAnimations();
+		Overlay->Widget->SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
+
+void UShooterEffectOverlayCache::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	for (auto It = Overlays.CreateIterator(); It; ++It)
+	{
+		UUserWidget* Widget = It.Value().Widget;
+		if (!IsValid(Widget) || Widget->GetWorld() == World)
+		{
+			if (IsValid(Widget))
+			{
+				Widget->RemoveFromParent();
+			}
+			It.RemoveCurrent();
+			DEC_DWORD_STAT(STAT_ShooterEffectOverlayWidgets);
+		}
+	}
+}
+
+void UShooterEffectOverlayCache::ClearOverlays()
+{
+	for (auto& It : Overlays)
+	{
+		if (IsValid(It.Value.Widget))
+		{
+			It.Value.Widget->RemoveFromParent();
+		}
+	}
+
+	DEC_DWORD_STAT_BY(STAT_ShooterEffectOverlayWidgets, Overlays.Num());
+	Overlays.Empty();
+}
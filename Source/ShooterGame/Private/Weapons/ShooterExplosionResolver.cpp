@@ -0,0 +1,241 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterExplosionResolver.h"
+#include "EngineUtils.h"
+
+DECLARE_CYCLE_STAT(TEXT("Resolve Explosions"), STAT_ShooterResolveExplosions, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosions Resolved"), STAT_ShooterExplosionsResolved, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosion Occlusion Traces"), STAT_ShooterExplosionTraces, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosion Occlusion Traces Shared"), STAT_ShooterExplosionTracesShared, STATGROUP_ShooterGame);
+
+static int32 BatchRadialDamage = 1;
+FAutoConsoleVariableRef CVarBatchRadialDamage(
+	TEXT("ShooterGame.BatchRadialDamage"),
+	BatchRadialDamage,
+	TEXT("Resolve explosion damage of a frame in one pass against a pawn grid.\n")
+	TEXT("0: ApplyRadialDamage per explosion, 1: batched (pawns only)"),
+	ECVF_Default);
+
+const float UShooterExplosionResolver::CellSize = 1000.0f;
+const float UShooterExplosionResolver::OcclusionShareDistance = 50.0f;
+
+bool UShooterExplosionResolver::ShouldCreateSubsystem(UObject* Outer) const
+{
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+bool UShooterExplosionResolver::IsBatchingEnabled()
+{
+	return BatchRadialDamage != 0;
+}
+
+void UShooterExplosionResolver::QueueExplosion(const FVector& Origin, float BaseDamage, float Radius, TSubclassOf<UDamageType> DamageType, AActor* DamageCauser, AController* InstigatedBy)
+{
+	FShooterQueuedExplosion& Explosion = PendingExplosions.AddDefaulted_GetRef();
+	Explosion.Origin = Origin;
+	Explosion.BaseDamage = BaseDamage;
+	Explosion.Radius = Radius;
+	Explosion.DamageType = DamageType;
+	Explosion.DamageCauser = DamageCauser;
+	Explosion.InstigatedBy = InstigatedBy;
+}
+
+void UShooterExplosionResolver::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterResolveExplosions);
+	INC_DWORD_STAT_BY(STAT_ShooterExplosionsResolved, PendingExplosions.Num());
+
+	BuildGrid();
+
+	// damage may kill pawns and queue more explosions, those wait for the next frame
+	TArray<FShooterQueuedExplosion> Explosions = MoveTemp(PendingExplosions);
+	PendingExplosions.Reset();
+	for (const FShooterQueuedExplosion& Explosion : Explosions)
+	{
+		ResolveExplosion(Explosion);
+	}
+
+	Targets.Reset();
+	Cells.Reset();
+}
+
+bool UShooterExplosionResolver::IsTickable() const
+{
+	return PendingExplosions.Num() > 0 && !IsTemplate();
+}
+
+TStatId UShooterExplosionResolver::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterExplosionResolver, STATGROUP_Tickables);
+}
+
+UWorld* UShooterExplosionResolver::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+/**
+ * Point where the line from Origin to the capsule center enters the capsule, Origin if it's inside.
+ * ApplyRadialDamage measures falloff to its trace hit on the way to the victim's center, the capsule stands in for the physics asset.
+ */
+static FVector GetCapsuleEntryPoint(const FVector& Origin, const FVector& Center, float Radius, float HalfHeight)
+{
+	const FVector ToOrigin = Origin - Center;
+	const float DistXY = ToOrigin.Size2D();
+	const float DistZ = FMath::Abs(ToOrigin.Z);
+	const float SafeRadius = FMath::Max(Radius, KINDA_SMALL_NUMBER);
+	const float SegmentHalfLength = FMath::Max(0.0f, HalfHeight - SafeRadius);
+
+	// how much the capsule has to grow around its center to reach the origin
+	float Scale;
+	if (DistZ * SafeRadius <= DistXY * SegmentHalfLength)
+	{
+		// through the cylinder
+		Scale = DistXY / SafeRadius;
+	}
+	else
+	{
+		// through a cap: DistXY^2 + (DistZ - Scale * SegmentHalfLength)^2 = (Scale * SafeRadius)^2, smallest root
+		const float DistSq = ToOrigin.SizeSquared();
+		const float B = 2.0f * DistZ * SegmentHalfLength;
+		const float Discriminant = FMath::Max(0.0f, B * B + 4.0f * (FMath::Square(SafeRadius) - FMath::Square(SegmentHalfLength)) * DistSq);
+		Scale = 2.0f * DistSq / (B + FMath::Sqrt(Discriminant));
+	}
+
+	return Scale > 1.0f ? Center + ToOrigin / Scale : Origin;
+}
+
+void UShooterExplosionResolver::BuildGrid()
+{
+	Targets.Reset();
+	Cells.Reset();
+	MaxTargetExtent = 0.0f;
+
+	for (TActorIterator<APawn> It(GetWorld()); It; ++It)
+	{
+		APawn* Pawn = *It;
+		if (Pawn == nullptr || Pawn->IsPendingKillPending() || !Pawn->CanBeDamaged())
+		{
+			continue;
+		}
+
+		FShooterExplosionTarget& Target = Targets.AddDefaulted_GetRef();
+		Target.Pawn = Pawn;
+		if (UCapsuleComponent* Capsule = Cast<UCapsuleComponent>(Pawn->GetRootComponent()))
+		{
+			Target.Center = Capsule->GetComponentLocation();
+			Capsule->GetScaledCapsuleSize(Target.Radius, Target.HalfHeight);
+		}
+		else
+		{
+			FVector BoundsExtent;
+			Pawn->GetActorBounds(true, Target.Center, BoundsExtent);
+			Target.Radius = FMath::Max(BoundsExtent.X, BoundsExtent.Y);
+			Target.HalfHeight = FMath::Max(BoundsExtent.Z, Target.Radius);
+		}
+
+		MaxTargetExtent = FMath::Max(MaxTargetExtent, Target.HalfHeight);
+		Cells.FindOrAdd(GetCell(Target.Center)).Add(Targets.Num() - 1);
+	}
+}
+
+void UShooterExplosionResolver::ResolveExplosion(const FShooterQueuedExplosion& Explosion)
+{
+	AActor* DamageCauser = Explosion.DamageCauser.Get();
+	AController* InstigatedBy = Explosion.InstigatedBy.Get();
+
+	// same falloff as UGameplayStatics::ApplyRadialDamage
+	FRadialDamageEvent DamageEvent;
+	DamageEvent.DamageTypeClass = Explosion.DamageType ? *Explosion.DamageType : UDamageType::StaticClass();
+	DamageEvent.Origin = Explosion.Origin;
+	DamageEvent.Params = FRadialDamageParams(Explosion.BaseDamage, 0.0f, 0.0f, Explosion.Radius, 1.0f);
+
+	const float SearchRadius = Explosion.Radius + MaxTargetExtent;
+	const FIntPoint MinCell = GetCell(Explosion.Origin - FVector(SearchRadius));
+	const FIntPoint MaxCell = GetCell(Explosion.Origin + FVector(SearchRadius));
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+		{
+			const TArray<int32, TInlineAllocator<4>>* Cell = Cells.Find(FIntPoint(CellX, CellY));
+			if (Cell == nullptr)
+			{
+				continue;
+			}
+
+			for (const int32 TargetIdx : *Cell)
+			{
+				FShooterExplosionTarget& Target = Targets[TargetIdx];
+				if (!IsValid(Target.Pawn))
+				{
+					continue;
+				}
+
+				// falloff is measured to this point, so it must be inside the radius to deal any damage
+				const FVector HitPoint = GetCapsuleEntryPoint(Explosion.Origin, Target.Center, Target.Radius, Target.HalfHeight);
+				if (FVector::DistSquared(HitPoint, Explosion.Origin) > FMath::Square(Explosion.Radius))
+				{
+					continue;
+				}
+
+				if (!IsVisibleFrom(Target, Explosion.Origin, DamageCauser))
+				{
+					continue;
+				}
+
+				FHitResult Hit(Target.Pawn, Cast<UPrimitiveComponent>(Target.Pawn->GetRootComponent()), HitPoint, (Explosion.Origin - Target.Center).GetSafeNormal());
+				Hit.TraceStart = Explosion.Origin;
+				Hit.TraceEnd = Target.Center;
+
+				DamageEvent.ComponentHits.Reset();
+				DamageEvent.ComponentHits.Add(Hit);
+				Target.Pawn->TakeDamage(Explosion.BaseDamage, DamageEvent, InstigatedBy, DamageCauser);
+			}
+		}
+	}
+}
+
+bool UShooterExplosionResolver::IsVisibleFrom(FShooterExplosionTarget& Target, const FVector& Origin, AActor* DamageCauser)
+{
+	const float ShareDistSq = FMath::Square(OcclusionShareDistance);
+	for (const FVector& TraceStart : Target.VisibleFrom)
+	{
+		if (FVector::DistSquared(TraceStart, Origin) <= ShareDistSq)
+		{
+			INC_DWORD_STAT(STAT_ShooterExplosionTracesShared);
+			return true;
+		}
+	}
+	for (const FVector& TraceStart : Target.BlockedFrom)
+	{
+		if (FVector::DistSquared(TraceStart, Origin) <= ShareDistSq)
+		{
+			INC_DWORD_STAT(STAT_ShooterExplosionTracesShared);
+			return false;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_ShooterExplosionTraces);
+
+	// same test as ApplyRadialDamage, blocked if anything but the pawn is in the way
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(ExplosionOcclusion), false, DamageCauser);
+	FHitResult Hit;
+	const bool bBlocked = GetWorld()->LineTraceSingleByChannel(Hit, Origin, Target.Center, ECC_Visibility, TraceParams) && Hit.GetActor() != Target.Pawn;
+
+	if (bBlocked)
+	{
+		Target.BlockedFrom.Add(Origin);
+	}
+	else
+	{
+		Target.VisibleFrom.Add(Origin);
+	}
+	return !bBlocked;
+}
+
+FIntPoint UShooterExplosionResolver::GetCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
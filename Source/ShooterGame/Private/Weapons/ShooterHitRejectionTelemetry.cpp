@@ -0,0 +1,233 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterHitRejectionTelemetry.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Hits Rejected"), STAT_ShooterHitsRejected, STATGROUP_ShooterGame);
+
+static float HitRejectionSummaryInterval = 30.0f;
+FAutoConsoleVariableRef CVarHitRejectionSummaryInterval(
+	TEXT("ShooterGame.HitRejectionSummaryInterval"),
+	HitRejectionSummaryInterval,
+	TEXT("Seconds between summaries of rejected client hits, written only if there were any."),
+	ECVF_Default);
+
+static int32 HitRejectionCSV = 1;
+FAutoConsoleVariableRef CVarHitRejectionCSV(
+	TEXT("ShooterGame.HitRejectionCSV"),
+	HitRejectionCSV,
+	TEXT("Append rejected client hit summaries to Saved/Profiling/HitRejections."),
+	ECVF_Default);
+
+const float FShooterHitRejectionStats::DistanceBuckets[NumBuckets - 1] = { 10.0f, 25.0f, 50.0f, 100.0f, 200.0f, 400.0f, 800.0f };
+const float FShooterHitRejectionStats::AngleBuckets[NumBuckets - 1] = { 1.0f, 2.0f, 5.0f, 10.0f, 20.0f, 45.0f, 90.0f };
+
+static const TCHAR* GetRejectionName(int32 Reason)
+{
+	switch ((EShooterHitRejection)Reason)
+	{
+	case EShooterHitRejection::ViewAngle:		return TEXT("ViewAngle");
+	case EShooterHitRejection::RewoundHitbox:	return TEXT("RewoundHitbox");
+	case EShooterHitRejection::Bounds:			return TEXT("Bounds");
+	default:									return TEXT("Other");
+	}
+}
+
+void FShooterHitRejectionStats::Add(EShooterHitRejection Reason, float DistanceError, float AngleError)
+{
+	Rejections[(int32)Reason]++;
+	Total++;
+
+	if (DistanceError >= 0.0f)
+	{
+		DistanceErrors[GetBucket(DistanceBuckets, DistanceError)]++;
+	}
+	if (AngleError >= 0.0f)
+	{
+		AngleErrors[GetBucket(AngleBuckets, AngleError)]++;
+	}
+}
+
+void FShooterHitRejectionStats::Reset()
+{
+	FMemory::Memzero(Rejections);
+	FMemory::Memzero(DistanceErrors);
+	FMemory::Memzero(AngleErrors);
+	Total = 0;
+}
+
+int32 FShooterHitRejectionStats::GetBucket(const float* Bounds, float Value)
+{
+	int32 Bucket = 0;
+	while (Bucket < NumBuckets - 1 && Value >= Bounds[Bucket])
+	{
+		Bucket++;
+	}
+	return Bucket;
+}
+
+bool UShooterHitRejectionTelemetry::ShouldCreateSubsystem(UObject* Outer) const
+{
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UShooterHitRejectionTelemetry::Deinitialize()
+{
+	// don't lose the tail of the match
+	Flush();
+
+	Super::Deinitialize();
+}
+
+void UShooterHitRejectionTelemetry::RecordRejection(APlayerController* PC, EShooterHitRejection Reason, float DistanceError, float AngleError)
+{
+	INC_DWORD_STAT(STAT_ShooterHitsRejected);
+
+	Connections.FindOrAdd(PC).Add(Reason, DistanceError, AngleError);
+	if (NextSummaryTime <= 0.0f)
+	{
+		NextSummaryTime = GetWorld()->GetTimeSeconds() + FMath::Max(1.0f, HitRejectionSummaryInterval);
+	}
+}
+
+void UShooterHitRejectionTelemetry::Flush()
+{
+	NextSummaryTime = 0.0f;
+	if (Connections.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<TPair<FString, FShooterHitRejectionStats>> Rows;
+	for (const auto& It : Connections)
+	{
+		const FShooterHitRejectionStats& Stats = It.Value;
+		const FString Player = GetConnectionName(It.Key.Get());
+		UE_LOG(LogShooterWeapon, Log, TEXT("Rejected %u client hits from %s (view angle %u, rewound hitbox %u, bounds %u, other %u)"),
+			Stats.Total, *Player,
+			Stats.Rejections[(int32)EShooterHitRejection::ViewAngle], Stats.Rejections[(int32)EShooterHitRejection::RewoundHitbox],
+			Stats.Rejections[(int32)EShooterHitRejection::Bounds], Stats.Rejections[(int32)EShooterHitRejection::Other]);
+
+		Rows.Emplace(Player, Stats);
+	}
+
+	if (HitRejectionCSV)
+	{
+		UWorld* World = GetWorld();
+		WriteCSV(World ? World->GetTimeSeconds() : 0.0f, Rows);
+	}
+
+	Connections.Reset();
+}
+
+void UShooterHitRejectionTelemetry::DumpStats() const
+{
+	UE_LOG(LogShooterWeapon, Log, TEXT("Hit rejections since the last summary (%d connections):"), Connections.Num());
+	for (const auto& It : Connections)
+	{
+		const FShooterHitRejectionStats& Stats = It.Value;
+		FString Reasons;
+		for (int32 Reason = 0; Reason < (int32)EShooterHitRejection::Max; Reason++)
+		{
+			Reasons += FString::Printf(TEXT(" %s=%u"), GetRejectionName(Reason), Stats.Rejections[Reason]);
+		}
+		UE_LOG(LogShooterWeapon, Log, TEXT("  %s: %u total,%s"), *GetConnectionName(It.Key.Get()), Stats.Total, *Reasons);
+	}
+}
+
+void UShooterHitRejectionTelemetry::Tick(float DeltaTime)
+{
+	if (GetWorld()->GetTimeSeconds() >= NextSummaryTime)
+	{
+		Flush();
+	}
+}
+
+bool UShooterHitRejectionTelemetry::IsTickable() const
+{
+	return NextSummaryTime > 0.0f && !IsTemplate();
+}
+
+TStatId UShooterHitRejectionTelemetry::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterHitRejectionTelemetry, STATGROUP_Tickables);
+}
+
+UWorld* UShooterHitRejectionTelemetry::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterHitRejectionTelemetry::WriteCSV(float Time, const TArray<TPair<FString, FShooterHitRejectionStats>>& Rows)
+{
+	FString CSV;
+	if (CSVFilename.IsEmpty())
+	{
+		CSVFilename = FPaths::ProfilingDir() / TEXT("HitRejections") / FString::Printf(TEXT("HitRejections-%s.csv"), *FDateTime::Now().ToString());
+
+		CSV += TEXT("Time,Player,Total");
+		for (int32 Reason = 0; Reason < (int32)EShooterHitRejection::Max; Reason++)
+		{
+			CSV += FString::Printf(TEXT(",%s"), GetRejectionName(Reason));
+		}
+		for (int32 Bucket = 0; Bucket < FShooterHitRejectionStats::NumBuckets; Bucket++)
+		{
+			CSV += Bucket < FShooterHitRejectionStats::NumBuckets - 1
+				? FString::Printf(TEXT(",Dist<%.0f"), FShooterHitRejectionStats::DistanceBuckets[Bucket])
+				: FString::Printf(TEXT(",Dist>=%.0f"), FShooterHitRejectionStats::DistanceBuckets[Bucket - 1]);
+		}
+		for (int32 Bucket = 0; Bucket < FShooterHitRejectionStats::NumBuckets; Bucket++)
+		{
+			CSV += Bucket < FShooterHitRejectionStats::NumBuckets - 1
+				? FString::Printf(TEXT(",Angle<%.0f"), FShooterHitRejectionStats::AngleBuckets[Bucket])
+				: FString::Printf(TEXT(",Angle>=%.0f"), FShooterHitRejectionStats::AngleBuckets[Bucket - 1]);
+		}
+		CSV += LINE_TERMINATOR;
+	}
+
+	for (const TPair<FString, FShooterHitRejectionStats>& Row : Rows)
+	{
+		const FShooterHitRejectionStats& Stats = Row.Value;
+		CSV += FString::Printf(TEXT("%.1f,\"%s\",%u"), Time, *Row.Key.Replace(TEXT("\""), TEXT("'")), Stats.Total);
+		for (int32 Reason = 0; Reason < (int32)EShooterHitRejection::Max; Reason++)
+		{
+			CSV += FString::Printf(TEXT(",%u"), Stats.Rejections[Reason]);
+		}
+		for (int32 Bucket = 0; Bucket < FShooterHitRejectionStats::NumBuckets; Bucket++)
+		{
+			CSV += FString::Printf(TEXT(",%u"), Stats.DistanceErrors[Bucket]);
+		}
+		for (int32 Bucket = 0; Bucket < FShooterHitRejectionStats::NumBuckets; Bucket++)
+		{
+			CSV += FString::Printf(TEXT(",%u"), Stats.AngleErrors[Bucket]);
+		}
+		CSV += LINE_TERMINATOR;
+	}
+
+	FFileHelper::SaveStringToFile(CSV, *CSVFilename, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+}
+
+FString UShooterHitRejectionTelemetry::GetConnectionName(const APlayerController* PC)
+{
+	if (PC == nullptr)
+	{
+		return TEXT("(disconnected)");
+	}
+
+	const FString PlayerName = PC->PlayerState ? PC->PlayerState->GetPlayerName() : PC->GetName();
+	const UNetConnection* Connection = PC->GetNetConnection();
+	return Connection ? FString::Printf(TEXT("%s (%s)"), *PlayerName, *Connection->LowLevelGetRemoteAddress(true)) : PlayerName;
+}
+
+FAutoConsoleCommandWithWorld ShooterDumpHitRejectionsCmd(TEXT("ShooterGame.DumpHitRejections"), TEXT("Prints rejected client hits per connection since the last summary"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UShooterHitRejectionTelemetry* Telemetry = World ? World->GetSubsystem<UShooterHitRejectionTelemetry>() : nullptr)
+		{
+			Telemetry->DumpStats();
+		}
+	})
+);
@@ -4,6 +4,11 @@
 #include "Weapons/ShooterProjectile.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Effects/ShooterExplosionEffect.h"
+#include "Weapons/ShooterExplosionResolver.h"
+#include "Weapons/ShooterProjectileMover.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles Launched"), STAT_ShooterProjectilesLaunched, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles Parked"), STAT_ShooterProjectilesParked, STATGROUP_ShooterGame);
 
 AShooterProjectile::AShooterProjectile(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -32,8 +37,11 @@ AShooterProjectile::AShooterProjectile(const FObjectInitializer& ObjectInitializ
 	MovementComp->bRotationFollowsVelocity = true;
 	MovementComp->ProjectileGravityScale = 0.f;
 
-	PrimaryActorTick.bCanEverTick = true;
-	PrimaryActorTick.TickGroup = TG_PrePhysics;
+	// moved by UShooterProjectileMover while flying
+	MovementComp->PrimaryComponentTick.bCanEverTick = false;
+	MovementComp->bAutoUpdateTickRegistration = false;
+
+	PrimaryActorTick.bCanEverTick = false;
 	SetRemoteRoleForBackwardsCompat(ROLE_SimulatedProxy);
 	bReplicates = true;
 	SetReplicatingMovement(true);
@@ -51,10 +59,129 @@ void AShooterProjectile::PostInitializeComponents()
 		OwnerWeapon->ApplyWeaponConfig(WeaponConfig);
 	}
 
-	SetLifeSpan( WeaponConfig.ProjectileLife );
 	MyController = GetInstigatorController();
 }
 
+void AShooterProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UShooterProjectileMover* Mover = GetWorld()->GetSubsystem<UShooterProjectileMover>())
+	{
+		Mover->UnregisterProjectile(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AShooterProjectile::TickMovement(float DeltaTime)
+{
+	if (MovementComp && MovementComp->IsActive())
+	{
+		MovementComp->TickComponent(DeltaTime * CustomTimeDilation, LEVELTICK_All, nullptr);
+	}
+}
+
+void AShooterProjectile::LaunchProjectile(const FVector& Origin, const FVector& ShootDirection)
+{
+	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	SetActorLocationAndRotation(Origin, ShootDirection.Rotation(), false, nullptr, ETeleportType::ResetPhysics);
+
+	// the weapon may have changed hands since the last flight
+	CollisionComp->MoveIgnoreActors.Reset();
+	CollisionComp->MoveIgnoreActors.Add(GetInstigator());
+	MyController = GetInstigatorController();
+
+	// and its stats may have been reloaded
+	if (AShooterWeapon_Projectile* OwnerWeapon = Cast<AShooterWeapon_Projectile>(GetOwner()))
+	{
+		OwnerWeapon->ApplyWeaponConfig(WeaponConfig);
+	}
+
+	ActivateProjectile();
+	MovementComp->Velocity = ShootDirection * MovementComp->InitialSpeed;
+
+	// 0 is never launched
+	State.LaunchId = (State.LaunchId == MAX_uint8) ? 1 : State.LaunchId + 1;
+	State.bActive = true;
+	State.bExploded = false;
+
+	GetWorldTimerManager().SetTimer(TimerHandle_ParkProjectile, this, &AShooterProjectile::ParkProjectile, WeaponConfig.ProjectileLife, false);
+	ForceNetUpdate();
+
+	INC_DWORD_STAT(STAT_ShooterProjectilesLaunched);
+}
+
+void AShooterProjectile::ActivateProjectile()
+{
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	// stopping on impact clears the updated component
+	MovementComp->SetUpdatedComponent(CollisionComp);
+	MovementComp->Activate(true);
+	if (UShooterProjectileMover* Mover = GetWorld()->GetSubsystem<UShooterProjectileMover>())
+	{
+		Mover->RegisterProjectile(this);
+	}
+
+	// blueprints pick whether the trail starts with the flight
+	if (ParticleComp && ParticleComp->bAutoActivate)
+	{
+		ParticleComp->ActivateSystem(true);
+	}
+
+	UAudioComponent* ProjAudioComp = FindComponentByClass<UAudioComponent>();
+	if (ProjAudioComp && ProjAudioComp->Sound)
+	{
+		ProjAudioComp->Play();
+	}
+}
+
+void AShooterProjectile::DeactivateProjectile()
+{
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+
+	MovementComp->StopMovementImmediately();
+	MovementComp->Deactivate();
+	if (UShooterProjectileMover* Mover = GetWorld()->GetSubsystem<UShooterProjectileMover>())
+	{
+		Mover->UnregisterProjectile(this);
+	}
+
+	if (ParticleComp)
+	{
+		ParticleComp->DeactivateImmediate();
+	}
+
+	UAudioComponent* ProjAudioComp = FindComponentByClass<UAudioComponent>();
+	if (ProjAudioComp)
+	{
+		ProjAudioComp->Stop();
+	}
+}
+
+void AShooterProjectile::ParkProjectile()
+{
+	GetWorldTimerManager().ClearTimer(TimerHandle_ParkProjectile);
+
+	AShooterWeapon_Projectile* OwnerWeapon = Cast<AShooterWeapon_Projectile>(GetOwner());
+	if (!IsValid(OwnerWeapon))
+	{
+		Destroy();
+		return;
+	}
+
+	State.bActive = false;
+	DeactivateProjectile();
+
+	// stay with the weapon, so the channel is kept open and replicated movement is idle
+	AttachToActor(OwnerWeapon, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	ForceNetUpdate();
+
+	INC_DWORD_STAT(STAT_ShooterProjectilesParked);
+	OwnerWeapon->ReturnProjectile(this);
+}
+
 void AShooterProjectile::InitVelocity(FVector& ShootDirection)
 {
 	if (MovementComp)
@@ -65,7 +192,7 @@ void AShooterProjectile::InitVelocity(FVector& ShootDirection)
 
 void AShooterProjectile::OnImpact(const FHitResult& HitResult)
 {
-	if (GetLocalRole() == ROLE_Authority && !bExploded)
+	if (GetLocalRole() == ROLE_Authority && State.bActive && !State.bExploded)
 	{
 		Explode(HitResult);
 		DisableAndDestroy();
@@ -84,7 +211,17 @@ void AShooterProjectile::Explode(const FHitResult& Impact)
 
 	if (WeaponConfig.ExplosionDamage > 0 && WeaponConfig.ExplosionRadius > 0 && WeaponConfig.DamageType)
 	{
-		UGameplayStatics::ApplyRadialDamage(this, WeaponConfig.ExplosionDamage, NudgedImpactLocation, WeaponConfig.ExplosionRadius, WeaponConfig.DamageType, TArray<AActor*>(), this, MyController.Get());
+		UShooterExplosionResolver* ExplosionResolver = GetWorld()->GetSubsystem<UShooterExplosionResolver>();
+
+		// [server] resolved with the other explosions of this frame
+		if (GetLocalRole() == ROLE_Authority && ExplosionResolver && UShooterExplosionResolver::IsBatchingEnabled())
+		{
+			ExplosionResolver->QueueExplosion(NudgedImpactLocation, WeaponConfig.ExplosionDamage, WeaponConfig.ExplosionRadius, WeaponConfig.DamageType, this, MyController.Get());
+		}
+		else
+		{
+			UGameplayStatics::ApplyRadialDamage(this, WeaponConfig.ExplosionDamage, NudgedImpactLocation, WeaponConfig.ExplosionRadius, WeaponConfig.DamageType, TArray<AActor*>(), this, MyController.Get());
+		}
 	}
 
 	if (ExplosionTemplate)
@@ -98,7 +235,7 @@ void AShooterProjectile::Explode(const FHitResult& Impact)
 		}
 	}
 
-	bExploded = true;
+	State.bExploded = true;
 }
 
 void AShooterProjectile::DisableAndDestroy()
@@ -112,11 +249,32 @@ void AShooterProjectile::DisableAndDestroy()
 	MovementComp->StopMovementImmediately();
 
 	// give clients some time to show explosion
-	SetLifeSpan( 2.0f );
+	GetWorldTimerManager().SetTimer(TimerHandle_ParkProjectile, this, &AShooterProjectile::ParkProjectile, 2.0f, false);
+}
+
+void AShooterProjectile::OnRep_State(const FShooterProjectileState& PreviousState)
+{
+	const bool bNewLaunch = State.LaunchId != PreviousState.LaunchId;
+	if (bNewLaunch && State.bActive)
+	{
+		ActivateProjectile();
+	}
+
+	// flights that started and ended between two updates are skipped
+	const bool bSawLaunch = bNewLaunch ? State.bActive : PreviousState.bActive;
+	if (bSawLaunch && State.bExploded && (bNewLaunch || !PreviousState.bExploded))
+	{
+		SimulateExplosion();
+	}
+
+	if (!State.bActive)
+	{
+		DeactivateProjectile();
+	}
 }
 
 ///CODE_SNIPPET_START: AActor::GetActorLocation AActor::GetActorRotation
-void AShooterProjectile::OnRep_Exploded()
+void AShooterProjectile::SimulateExplosion()
 {
 	FVector ProjDirection = GetActorForwardVector();
 
@@ -147,5 +305,5 @@ void AShooterProjectile::GetLifetimeReplicatedProps( TArray< FLifetimeProperty >
 {
 	Super::GetLifetimeReplicatedProps( OutLifetimeProps );
 	
-	DOREPLIFETIME( AShooterProjectile, bExploded );
+	DOREPLIFETIME( AShooterProjectile, State );
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterProjectileMover.h"
+#include "Weapons/ShooterProjectile.h"
+
+DECLARE_CYCLE_STAT(TEXT("Move Projectiles"), STAT_ShooterMoveProjectiles, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Moving Projectiles"), STAT_ShooterMovingProjectiles, STATGROUP_ShooterGame);
+
+bool UShooterProjectileMover::ShouldCreateSubsystem(UObject* Outer) const
+{
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UShooterProjectileMover::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_ShooterMovingProjectiles, NumProjectiles);
+	Projectiles.Empty();
+	NumProjectiles = 0;
+
+	Super::Deinitialize();
+}
+
+void UShooterProjectileMover::RegisterProjectile(AShooterProjectile* Projectile)
+{
+	const TWeakObjectPtr<AShooterProjectile> WeakProjectile(Projectile);
+	if (Projectile && !Projectiles.Contains(WeakProjectile))
+	{
+		Projectiles.Add(WeakProjectile);
+		NumProjectiles++;
+		INC_DWORD_STAT(STAT_ShooterMovingProjectiles);
+	}
+}
+
+void UShooterProjectileMover::UnregisterProjectile(AShooterProjectile* Projectile)
+{
+	// keep indices stable, the slot is dropped after the move
+	const int32 Index = Projectiles.IndexOfByKey(TWeakObjectPtr<AShooterProjectile>(Projectile));
+	if (Index != INDEX_NONE)
+	{
+		Projectiles[Index].Reset();
+		NumProjectiles--;
+		DEC_DWORD_STAT(STAT_ShooterMovingProjectiles);
+	}
+}
+
+void UShooterProjectileMover::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterMoveProjectiles);
+
+	// impacts can park projectiles and launches can add them while moving
+	for (int32 Index = 0; Index < Projectiles.Num(); Index++)
+	{
+		AShooterProjectile* Projectile = Projectiles[Index].Get();
+		if (Projectile && !Projectile->IsPendingKillPending())
+		{
+			Projectile->TickMovement(DeltaTime);
+		}
+	}
+
+	for (int32 Index = Projectiles.Num() - 1; Index >= 0; Index--)
+	{
+		if (!Projectiles[Index].IsValid())
+		{
+			// destroyed without unregistering
+			if (!Projectiles[Index].IsExplicitlyNull())
+			{
+				NumProjectiles--;
+				DEC_DWORD_STAT(STAT_ShooterMovingProjectiles);
+			}
+			Projectiles.RemoveAtSwap(Index, 1, false);
+		}
+	}
+}
+
+bool UShooterProjectileMover::IsTickable() const
+{
+	return Projectiles.Num() > 0 && !IsTemplate();
+}
+
+TStatId UShooterProjectileMover::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterProjectileMover, STATGROUP_Tickables);
+}
+
+UWorld* UShooterProjectileMover::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterProjectileMover::DumpStats() const
+{
+	UE_LOG(LogShooterWeapon, Log, TEXT("Projectile mover: %d projectiles moving"), NumProjectiles);
+}
+
+FAutoConsoleCommandWithWorld ShooterDumpProjectileMoverCmd(TEXT("ShooterGame.DumpProjectileMover"), TEXT("Prints the number of projectiles moved by the central projectile mover"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UShooterProjectileMover* Mover = World ? World->GetSubsystem<UShooterProjectileMover>() : nullptr)
+		{
+			Mover->DumpStats();
+		}
+	})
+);
@@ -9,6 +9,18 @@
 #include "UI/ShooterHUD.h"
 #include "MatineeCameraShake.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Catch Up Shots"), STAT_ShooterCatchUpShots, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shots Dropped (hitch)"), STAT_ShooterShotsDropped, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ticking Weapons"), STAT_ShooterTickingWeapons, STATGROUP_ShooterGame);
+
+static int32 MaxShotsPerFrame = 8;
+FAutoConsoleVariableRef CVarMaxShotsPerFrame(
+	TEXT("ShooterGame.MaxShotsPerFrame"),
+	MaxShotsPerFrame,
+	TEXT("Max number of shots an automatic weapon fires in one frame to catch up with its fire rate.\n")
+	TEXT("Shots still due after that are dropped, so a hitch doesn't empty the clip at once."),
+	ECVF_Default);
+
 AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	Mesh1P = ObjectInitializer.CreateDefaultSubobject<USkeletalMeshComponent>(this, TEXT("WeaponMesh1P"));
@@ -45,8 +57,13 @@ AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Su
 	CurrentAmmoInClip = 0;
 	BurstCounter = 0;
 	LastFireTime = 0.0f;
+	NextShotTime = 0.0f;
+	CurrentShotTime = 0.0f;
+	StatsTable = nullptr;
+	StatsIndex = INDEX_NONE;
 
-	PrimaryActorTick.bCanEverTick = true;
+	// firing and reloading run on timers, weapons don't need a tick
+	PrimaryActorTick.bCanEverTick = false;
 	PrimaryActorTick.TickGroup = TG_PrePhysics;
 	SetRemoteRoleForBackwardsCompat(ROLE_SimulatedProxy);
 	bReplicates = true;
@@ -57,15 +74,19 @@ void AShooterWeapon::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
-	if (WeaponConfig.InitialClips > 0)
-	{
-		CurrentAmmoInClip = WeaponConfig.AmmoPerClip;
-		CurrentAmmo = WeaponConfig.AmmoPerClip * WeaponConfig.InitialClips;
-	}
+	RefreshStats();
+	ResetAmmo();
 
 	DetachMeshFromPawn();
 }
 
+void AShooterWeapon::RefreshStats()
+{
+	UWorld* World = GetWorld();
+	StatsTable = World ? World->GetSubsystem<UShooterWeaponStats>() : nullptr;
+	StatsIndex = (StatsTable && StatsId != NAME_None) ? StatsTable->FindWeaponIndex(StatsId) : INDEX_NONE;
+}
+
 void AShooterWeapon::Destroyed()
 {
 	Super::Destroyed();
@@ -73,6 +94,27 @@ void AShooterWeapon::Destroyed()
 	StopSimulatingWeaponFire();
 }
 
+void AShooterWeapon::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// should stay at 0, see the constructor
+	if (PrimaryActorTick.bCanEverTick)
+	{
+		INC_DWORD_STAT(STAT_ShooterTickingWeapons);
+	}
+}
+
+void AShooterWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (PrimaryActorTick.bCanEverTick)
+	{
+		DEC_DWORD_STAT(STAT_ShooterTickingWeapons);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 ////////////////////////////////////////////////////////////////////////
 //New Addition.
 void AShooterWeapon::SetAmmo(int32 Ammo)
@@ -85,6 +127,14 @@ void AShooterWeapon::SetAmmoInClip(int32 Ammo)
 	CurrentAmmoInClip = Ammo;
 }
 
+void AShooterWeapon::ResetAmmo()
+{
+	const FWeaponData& Stats = GetWeaponStats();
+	const int32 InitialClips = FMath::Max(0, Stats.InitialClips);
+	CurrentAmmoInClip = InitialClips > 0 ? Stats.AmmoPerClip : 0;
+	CurrentAmmo = Stats.AmmoPerClip * InitialClips;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Inventory
 
@@ -207,6 +257,8 @@ void AShooterWeapon::AttachMeshToPawn()
 			USkeletalMeshComponent* PawnMesh3p = MyPawn->GetSpecifcPawnMesh(false);
 			Mesh1P->SetHiddenInGame( false );
 			Mesh3P->SetHiddenInGame( false );
+			Mesh1P->SetComponentTickEnabled(true);
+			Mesh3P->SetComponentTickEnabled(true);
 			Mesh1P->AttachToComponent(PawnMesh1p, FAttachmentTransformRules::KeepRelativeTransform, AttachPoint);
 			Mesh3P->AttachToComponent(PawnMesh3p, FAttachmentTransformRules::KeepRelativeTransform, AttachPoint);
 		}
@@ -216,17 +268,21 @@ void AShooterWeapon::AttachMeshToPawn()
 			USkeletalMeshComponent* UsePawnMesh = MyPawn->GetPawnMesh();
 			UseWeaponMesh->AttachToComponent(UsePawnMesh, FAttachmentTransformRules::KeepRelativeTransform, AttachPoint);
 			UseWeaponMesh->SetHiddenInGame( false );
+			UseWeaponMesh->SetComponentTickEnabled(true);
 		}
 	}
 }
 
 void AShooterWeapon::DetachMeshFromPawn()
 {
+	// weapons in the inventory don't animate
 	Mesh1P->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
 	Mesh1P->SetHiddenInGame(true);
+	Mesh1P->SetComponentTickEnabled(false);
 
 	Mesh3P->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
 	Mesh3P->SetHiddenInGame(true);
+	Mesh3P->SetComponentTickEnabled(false);
 }
 
 
@@ -276,7 +332,7 @@ void AShooterWeapon::StartReload(bool bFromReplication)
 		float AnimDuration = PlayWeaponAnimation(ReloadAnim);		
 		if (AnimDuration <= 0.0f)
 		{
-			AnimDuration = WeaponConfig.NoAnimReloadDuration;
+			AnimDuration = GetWeaponStats().NoAnimReloadDuration;
 		}
 
 		GetWorldTimerManager().SetTimer(TimerHandle_StopReload, this, &AShooterWeapon::StopReload, AnimDuration, false);
@@ -360,7 +416,7 @@ bool AShooterWeapon::CanFire() const
 bool AShooterWeapon::CanReload() const
 {
 	bool bCanReload = (!MyPawn || MyPawn->CanReload());
-	bool bGotAmmo = ( CurrentAmmoInClip < WeaponConfig.AmmoPerClip) && (CurrentAmmo - CurrentAmmoInClip > 0 || HasInfiniteClip());
+	bool bGotAmmo = ( CurrentAmmoInClip < GetWeaponStats().AmmoPerClip) && (CurrentAmmo - CurrentAmmoInClip > 0 || HasInfiniteClip());
 	bool bStateOKToReload = ( ( CurrentState ==  EWeaponState::Idle ) || ( CurrentState == EWeaponState::Firing) );
 	return ( ( bCanReload == true ) && ( bGotAmmo == true ) && ( bStateOKToReload == true) );	
 }
@@ -371,7 +427,7 @@ bool AShooterWeapon::CanReload() const
 
 void AShooterWeapon::GiveAmmo(int AddAmount)
 {
-	const int32 MissingAmmo = FMath::Max(0, WeaponConfig.MaxAmmo - CurrentAmmo);
+	const int32 MissingAmmo = FMath::Max(0, GetWeaponStats().MaxAmmo - CurrentAmmo);
 	AddAmount = FMath::Min(AddAmount, MissingAmmo);
 	CurrentAmmo += AddAmount;
 
@@ -428,21 +484,43 @@ void AShooterWeapon::UseAmmo()
 
 void AShooterWeapon::HandleReFiring()
 {
-	// Update TimerIntervalAdjustment
-	UWorld* MyWorld = GetWorld();
-
-	float SlackTimeThisFrame = FMath::Max(0.0f, (MyWorld->TimeSeconds - LastFireTime) - WeaponConfig.TimeBetweenShots);
+	const float Now = GetWorld()->GetTimeSeconds();
+	if (!bAllowAutomaticWeaponCatchup)
+	{
+		HandleFiring();
+		return;
+	}
 
-	if (bAllowAutomaticWeaponCatchup)
+	// the timer wakes us once per frame at most, fire every shot that came due since then at its own time
+	int32 NumShots = 0;
+	do
 	{
-		TimerIntervalAdjustment -= SlackTimeThisFrame;
+		if (NumShots > 0)
+		{
+			INC_DWORD_STAT(STAT_ShooterCatchUpShots);
+		}
+		HandleFiringAt(FMath::Min(NextShotTime, Now));
+		NumShots++;
 	}
+	while (bRefiring && NextShotTime <= Now && NumShots < MaxShotsPerFrame);
 
-	HandleFiring();
+	// too far behind after a hitch, carry on from now
+	if (bRefiring && NextShotTime <= Now)
+	{
+		INC_DWORD_STAT_BY(STAT_ShooterShotsDropped, FMath::FloorToInt((Now - NextShotTime) / GetWeaponStats().TimeBetweenShots) + 1);
+		NextShotTime = Now;
+	}
 }
 
 void AShooterWeapon::HandleFiring()
 {
+	HandleFiringAt(GetWorld()->GetTimeSeconds());
+}
+
+void AShooterWeapon::HandleFiringAt(float ShotTime)
+{
+	CurrentShotTime = ShotTime;
+
 	if ((CurrentAmmoInClip > 0 || HasInfiniteClip() || HasInfiniteAmmo()) && CanFire())
 	{
 		if (GetNetMode() != NM_DedicatedServer)
@@ -502,16 +580,22 @@ void AShooterWeapon::HandleFiring()
 			StartReload();
 		}
 
-		// setup refire timer
-		bRefiring = (CurrentState == EWeaponState::Firing && WeaponConfig.TimeBetweenShots > 0.0f);
+		// setup refire timer, due time is kept exact and only the wake up is rounded to frames
+		const float TimeBetweenShots = GetWeaponStats().TimeBetweenShots;
+		bRefiring = (CurrentState == EWeaponState::Firing && TimeBetweenShots > 0.0f);
 		if (bRefiring)
 		{
-			GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AShooterWeapon::HandleReFiring, FMath::Max<float>(WeaponConfig.TimeBetweenShots + TimerIntervalAdjustment, SMALL_NUMBER), false);
-			TimerIntervalAdjustment = 0.f;
+			NextShotTime = ShotTime + TimeBetweenShots;
+			GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AShooterWeapon::HandleReFiring, FMath::Max<float>(NextShotTime - GetWorld()->GetTimeSeconds(), SMALL_NUMBER), false);
 		}
 	}
 
-	LastFireTime = GetWorld()->GetTimeSeconds();
+	LastFireTime = ShotTime;
+}
+
+float AShooterWeapon::GetShotAge() const
+{
+	return FMath::Max(0.0f, GetWorld()->GetTimeSeconds() - CurrentShotTime);
 }
 
 bool AShooterWeapon::ServerHandleFiring_Validate()
@@ -537,11 +621,11 @@ void AShooterWeapon::ServerHandleFiring_Implementation()
 
 void AShooterWeapon::ReloadWeapon()
 {
-	int32 ClipDelta = FMath::Min(WeaponConfig.AmmoPerClip - CurrentAmmoInClip, CurrentAmmo - CurrentAmmoInClip);
+	int32 ClipDelta = FMath::Min(GetWeaponStats().AmmoPerClip - CurrentAmmoInClip, CurrentAmmo - CurrentAmmoInClip);
 
 	if (HasInfiniteClip())
 	{
-		ClipDelta = WeaponConfig.AmmoPerClip - CurrentAmmoInClip;
+		ClipDelta = GetWeaponStats().AmmoPerClip - CurrentAmmoInClip;
 	}
 
 	if (ClipDelta > 0)
@@ -606,10 +690,12 @@ void AShooterWeapon::OnBurstStarted()
 {
 	// start firing, can be delayed to satisfy TimeBetweenShots
 	const float GameTime = GetWorld()->GetTimeSeconds();
-	if (LastFireTime > 0 && WeaponConfig.TimeBetweenShots > 0.0f &&
-		LastFireTime + WeaponConfig.TimeBetweenShots > GameTime)
+	const float TimeBetweenShots = GetWeaponStats().TimeBetweenShots;
+	if (LastFireTime > 0 && TimeBetweenShots > 0.0f &&
+		LastFireTime + TimeBetweenShots > GameTime)
 	{
-		GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AShooterWeapon::HandleFiring, LastFireTime + WeaponConfig.TimeBetweenShots - GameTime, false);
+		NextShotTime = LastFireTime + TimeBetweenShots;
+		GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AShooterWeapon::HandleReFiring, NextShotTime - GameTime, false);
 	}
 	else
 	{
@@ -630,9 +716,6 @@ void AShooterWeapon::OnBurstFinished()
 	
 	GetWorldTimerManager().ClearTimer(TimerHandle_HandleFiring);
 	bRefiring = false;
-
-	// reset firing interval adjustment
-	TimerIntervalAdjustment = 0.0f;
 }
 
 
@@ -842,20 +925,32 @@ void AShooterWeapon::SimulateWeaponFire()
 				AController* PlayerCon = MyPawn->GetController();				
 				if( PlayerCon != NULL )
 				{
-					Mesh1P->GetSocketLocation(MuzzleAttachPoint);
-					MuzzlePSC = UGameplayStatics::SpawnEmitterAttached(MuzzleFX, Mesh1P, MuzzleAttachPoint);
-					MuzzlePSC->bOwnerNoSee = false;
-					MuzzlePSC->bOnlyOwnerSee = true;
-
-					Mesh3P->GetSocketLocation(MuzzleAttachPoint);
-					MuzzlePSCSecondary = UGameplayStatics::SpawnEmitterAttached(MuzzleFX, Mesh3P, MuzzleAttachPoint);
-					MuzzlePSCSecondary->bOwnerNoSee = true;
-					MuzzlePSCSecondary->bOnlyOwnerSee = false;				
+					MuzzlePSC = MuzzleFXPool.Acquire(this, MuzzleFX, Mesh1P, MuzzleAttachPoint);
+					if (MuzzlePSC)
+					{
+						MuzzlePSC->SetOwnerNoSee(false);
+						MuzzlePSC->SetOnlyOwnerSee(true);
+						MuzzlePSC->ActivateSystem(true);
+					}
+
+					MuzzlePSCSecondary = MuzzleFXPool.Acquire(this, MuzzleFX, Mesh3P, MuzzleAttachPoint);
+					if (MuzzlePSCSecondary)
+					{
+						MuzzlePSCSecondary->SetOwnerNoSee(true);
+						MuzzlePSCSecondary->SetOnlyOwnerSee(false);
+						MuzzlePSCSecondary->ActivateSystem(true);
+					}
 				}				
 			}
 			else
 			{
-				MuzzlePSC = UGameplayStatics::SpawnEmitterAttached(MuzzleFX, UseWeaponMesh, MuzzleAttachPoint);
+				MuzzlePSC = MuzzleFXPool.Acquire(this, MuzzleFX, UseWeaponMesh, MuzzleAttachPoint);
+				if (MuzzlePSC)
+				{
+					MuzzlePSC->SetOwnerNoSee(false);
+					MuzzlePSC->SetOnlyOwnerSee(false);
+					MuzzlePSC->ActivateSystem(true);
+				}
 			}
 		}
 	}
@@ -975,24 +1070,24 @@ int32 AShooterWeapon::GetCurrentAmmoInClip() const
 
 int32 AShooterWeapon::GetAmmoPerClip() const
 {
-	return WeaponConfig.AmmoPerClip;
+	return GetWeaponStats().AmmoPerClip;
 }
 
 int32 AShooterWeapon::GetMaxAmmo() const
 {
-	return WeaponConfig.MaxAmmo;
+	return GetWeaponStats().MaxAmmo;
 }
 
 bool AShooterWeapon::HasInfiniteAmmo() const
 {
 	const AShooterPlayerController* MyPC = (MyPawn != NULL) ? Cast<const AShooterPlayerController>(MyPawn->Controller) : NULL;
-	return WeaponConfig.bInfiniteAmmo || (MyPC && MyPC->HasInfiniteAmmo());
+	return GetWeaponStats().bInfiniteAmmo || (MyPC && MyPC->HasInfiniteAmmo());
 }
 
 bool AShooterWeapon::HasInfiniteClip() const
 {
 	const AShooterPlayerController* MyPC = (MyPawn != NULL) ? Cast<const AShooterPlayerController>(MyPawn->Controller) : NULL;
-	return WeaponConfig.bInfiniteClip || (MyPC && MyPC->HasInfiniteClip());
+	return GetWeaponStats().bInfiniteClip || (MyPC && MyPC->HasInfiniteClip());
 }
 
 float AShooterWeapon::GetEquipStartedTime() const
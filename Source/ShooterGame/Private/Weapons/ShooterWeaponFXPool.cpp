@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterWeaponFXPool.h"
+#include "Particles/ParticleSystemComponent.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapon FX Reused"), STAT_ShooterWeaponFXReused, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapon FX Components Created"), STAT_ShooterWeaponFXComponents, STATGROUP_ShooterGame);
+
+UParticleSystemComponent* FShooterWeaponFXPool::Acquire(AActor* Owner, UParticleSystem* Template, USceneComponent* AttachTo, FName SocketName)
+{
+	if (Owner == nullptr || Template == nullptr)
+	{
+		return nullptr;
+	}
+
+	// prefer a free component that is already set up the same way
+	UParticleSystemComponent* PSC = nullptr;
+	UParticleSystemComponent* FreePSC = nullptr;
+	for (int32 PSCIdx = Components.Num() - 1; PSCIdx >= 0; PSCIdx--)
+	{
+		UParticleSystemComponent* Candidate = Components[PSCIdx];
+		if (!IsValid(Candidate))
+		{
+			Components.RemoveAtSwap(PSCIdx);
+			continue;
+		}
+
+		if (IsFree(Candidate))
+		{
+			if (Candidate->Template == Template && Candidate->GetAttachParent() == AttachTo && Candidate->GetAttachSocketName() == SocketName)
+			{
+				PSC = Candidate;
+				break;
+			}
+			FreePSC = FreePSC ? FreePSC : Candidate;
+		}
+	}
+	PSC = PSC ? PSC : FreePSC;
+
+	if (PSC == nullptr && Components.Num() < MaxComponents)
+	{
+		PSC = NewObject<UParticleSystemComponent>(Owner);
+		PSC->bAutoActivate = false;
+		PSC->bAutoDestroy = false;
+		PSC->SetTemplate(Template);
+		if (AttachTo)
+		{
+			PSC->SetupAttachment(AttachTo, SocketName);
+		}
+		PSC->RegisterComponent();
+
+		Components.Add(PSC);
+		INC_DWORD_STAT(STAT_ShooterWeaponFXComponents);
+		return PSC;
+	}
+
+	// all busy, restart the oldest
+	if (PSC == nullptr && Components.Num() > 0)
+	{
+		NextToRecycle = NextToRecycle % Components.Num();
+		PSC = Components[NextToRecycle++];
+	}
+
+	if (PSC)
+	{
+		INC_DWORD_STAT(STAT_ShooterWeaponFXReused);
+
+		if (PSC->Template != Template)
+		{
+			PSC->SetTemplate(Template);
+		}
+
+		if (AttachTo)
+		{
+			if (PSC->GetAttachParent() != AttachTo || PSC->GetAttachSocketName() != SocketName)
+			{
+				PSC->AttachToComponent(AttachTo, FAttachmentTransformRules::SnapToTargetNotIncludingScale, SocketName);
+			}
+		}
+		else if (PSC->GetAttachParent())
+		{
+			PSC->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+		}
+	}
+
+	return PSC;
+}
+
+bool FShooterWeaponFXPool::IsFree(UParticleSystemComponent* PSC)
+{
+	return !PSC->IsActive() || PSC->HasCompleted();
+}
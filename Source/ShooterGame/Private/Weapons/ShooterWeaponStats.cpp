@@ -0,0 +1,226 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterWeaponStats.h"
+#include "Weapons/ShooterWeapon.h"
+#include "Player/ShooterPlayerController.h"
+#include "EngineUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+/** file passed to the last ShooterGame.ReloadWeaponStats, empty when the configured table is in use. Outlives the world so the next map loads it too. */
+static FString ReloadedStatsFile;
+
+bool UShooterWeaponStats::ShouldCreateSubsystem(UObject* Outer) const
+{
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UShooterWeaponStats::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (!WeaponStatsTable.IsNull())
+	{
+		const UDataTable* Table = WeaponStatsTable.LoadSynchronous();
+		if (Table)
+		{
+			LoadRows(Table);
+		}
+		else
+		{
+			UE_LOG(LogShooterWeapon, Warning, TEXT("Weapon stats table %s couldn't be loaded, weapons use their own config"), *WeaponStatsTable.ToString());
+		}
+	}
+
+	if (!ReloadedStatsFile.IsEmpty())
+	{
+		bStatsReloaded = LoadFile(ReloadedStatsFile);
+	}
+}
+
+int32 UShooterWeaponStats::FindWeaponIndex(FName WeaponId) const
+{
+	const int32* WeaponIndex = WeaponIndices.Find(WeaponId);
+	return WeaponIndex ? *WeaponIndex : INDEX_NONE;
+}
+
+bool UShooterWeaponStats::Reload(const FString& FilePath)
+{
+	if (FilePath.IsEmpty())
+	{
+		if (WeaponStatsTable.IsNull())
+		{
+			UE_LOG(LogShooterWeapon, Warning, TEXT("No weapon stats table configured, pass a csv or json file to reload from"));
+			return false;
+		}
+
+		const UDataTable* Table = WeaponStatsTable.LoadSynchronous();
+		if (Table == nullptr)
+		{
+			return false;
+		}
+		LoadRows(Table);
+	}
+	else if (!LoadFile(FilePath))
+	{
+		return false;
+	}
+
+	ReloadedStatsFile = FilePath;
+	bStatsReloaded = true;
+	RefreshWeapons();
+
+	// clients only have the configured table
+	if (GetWorld()->GetNetMode() != NM_Client)
+	{
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			SendStats(Cast<AShooterPlayerController>(It->Get()));
+		}
+	}
+
+	UE_LOG(LogShooterWeapon, Log, TEXT("Reloaded stats of %d weapons"), WeaponIds.Num());
+	return true;
+}
+
+void UShooterWeaponStats::SendReloadedStats(AShooterPlayerController* PC) const
+{
+	if (bStatsReloaded)
+	{
+		SendStats(PC);
+	}
+}
+
+void UShooterWeaponStats::ReceiveStats(const TArray<FName>& RowNames, const TArray<FShooterWeaponStatsRow>& Rows)
+{
+	if (RowNames.Num() != Rows.Num())
+	{
+		UE_LOG(LogShooterWeapon, Warning, TEXT("Got %d weapon stats rows for %d names from the server, ignoring them"), Rows.Num(), RowNames.Num());
+		return;
+	}
+
+	for (int32 RowIndex = 0; RowIndex < Rows.Num(); RowIndex++)
+	{
+		SetRow(RowNames[RowIndex], Rows[RowIndex]);
+	}
+	RefreshWeapons();
+
+	UE_LOG(LogShooterWeapon, Log, TEXT("Received stats of %d weapons from the server"), Rows.Num());
+}
+
+bool UShooterWeaponStats::LoadFile(const FString& FilePath)
+{
+	FString Contents;
+	if (!FFileHelper::LoadFileToString(Contents, *FilePath))
+	{
+		UE_LOG(LogShooterWeapon, Warning, TEXT("Couldn't read weapon stats from %s"), *FilePath);
+		return false;
+	}
+
+	UDataTable* Table = NewObject<UDataTable>(GetTransientPackage());
+	Table->RowStruct = FShooterWeaponStatsRow::StaticStruct();
+
+	const bool bJson = FPaths::GetExtension(FilePath).Equals(TEXT("json"), ESearchCase::IgnoreCase);
+	const TArray<FString> Problems = bJson ? Table->CreateTableFromJSONString(Contents) : Table->CreateTableFromCSVString(Contents);
+	for (const FString& Problem : Problems)
+	{
+		UE_LOG(LogShooterWeapon, Warning, TEXT("%s: %s"), *FilePath, *Problem);
+	}
+	LoadRows(Table);
+	return true;
+}
+
+void UShooterWeaponStats::RefreshWeapons()
+{
+	// weapons that had no row may have one now
+	for (TActorIterator<AShooterWeapon> It(GetWorld()); It; ++It)
+	{
+		It->RefreshStats();
+	}
+}
+
+void UShooterWeaponStats::SendStats(AShooterPlayerController* PC) const
+{
+	// a listen server's own players share the server's rows
+	if (PC == nullptr || PC->IsLocalController())
+	{
+		return;
+	}
+
+	TArray<FShooterWeaponStatsRow> Rows;
+	Rows.SetNum(WeaponIds.Num());
+	for (int32 WeaponIndex = 0; WeaponIndex < WeaponIds.Num(); WeaponIndex++)
+	{
+		Rows[WeaponIndex].Weapon = WeaponStats[WeaponIndex];
+		Rows[WeaponIndex].Instant = InstantStats[WeaponIndex];
+		Rows[WeaponIndex].Projectile = ProjectileStats[WeaponIndex];
+	}
+	PC->ClientReceiveWeaponStats(WeaponIds, Rows);
+}
+
+void UShooterWeaponStats::LoadRows(const UDataTable* Table)
+{
+	check(Table);
+	if (Table->GetRowStruct() == nullptr || !Table->GetRowStruct()->IsChildOf(FShooterWeaponStatsRow::StaticStruct()))
+	{
+		UE_LOG(LogShooterWeapon, Warning, TEXT("Weapon stats table %s doesn't use FShooterWeaponStatsRow"), *GetNameSafe(Table));
+		return;
+	}
+
+	// indices already handed out to weapons stay valid, rows dropped from the table keep their last stats
+	Table->ForeachRow<FShooterWeaponStatsRow>(TEXT("UShooterWeaponStats::LoadRows"), [this](const FName& RowName, const FShooterWeaponStatsRow& Row)
+	{
+		SetRow(RowName, Row);
+	});
+}
+
+void UShooterWeaponStats::SetRow(FName RowName, const FShooterWeaponStatsRow& Row)
+{
+	int32& WeaponIndex = WeaponIndices.FindOrAdd(RowName, INDEX_NONE);
+	if (WeaponIndex == INDEX_NONE)
+	{
+		WeaponIndex = WeaponIds.Add(RowName);
+		WeaponStats.AddDefaulted();
+		InstantStats.AddDefaulted();
+		ProjectileStats.AddDefaulted();
+	}
+
+	WeaponStats[WeaponIndex] = Row.Weapon;
+	InstantStats[WeaponIndex] = Row.Instant;
+	ProjectileStats[WeaponIndex] = Row.Projectile;
+}
+
+void UShooterWeaponStats::DumpStats() const
+{
+	UE_LOG(LogShooterWeapon, Log, TEXT("Weapon stats: %d weapons from %s"), WeaponIds.Num(), ReloadedStatsFile.IsEmpty() ? *WeaponStatsTable.ToString() : *ReloadedStatsFile);
+	for (int32 WeaponIndex = 0; WeaponIndex < WeaponIds.Num(); WeaponIndex++)
+	{
+		const FWeaponData& Weapon = WeaponStats[WeaponIndex];
+		const FInstantWeaponData& Instant = InstantStats[WeaponIndex];
+		const FProjectileWeaponData& Projectile = ProjectileStats[WeaponIndex];
+		UE_LOG(LogShooterWeapon, Log, TEXT("  [%d] %s: %.3fs between shots, clip %d, max %d, hit damage %d, explosion damage %d"),
+			WeaponIndex, *WeaponIds[WeaponIndex].ToString(), Weapon.TimeBetweenShots, Weapon.AmmoPerClip, Weapon.MaxAmmo, Instant.HitDamage, Projectile.ExplosionDamage);
+	}
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterReloadWeaponStatsCmd(TEXT("ShooterGame.ReloadWeaponStats"), TEXT("Reloads weapon stats from the configured table, or from the csv / json file passed. Run it on the server, clients get the new stats from it."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UShooterWeaponStats* WeaponStats = World ? World->GetSubsystem<UShooterWeaponStats>() : nullptr)
+		{
+			WeaponStats->Reload(Args.Num() > 0 ? Args[0] : FString());
+		}
+	})
+);
+
+FAutoConsoleCommandWithWorld ShooterDumpWeaponStatsCmd(TEXT("ShooterGame.DumpWeaponStats"), TEXT("Prints the weapon stats table"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UShooterWeaponStats* WeaponStats = World ? World->GetSubsystem<UShooterWeaponStats>() : nullptr)
+		{
+			WeaponStats->DumpStats();
+		}
+	})
+);
@@ -4,10 +4,251 @@
 #include "Weapons/ShooterWeapon_Instant.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Effects/ShooterImpactEffect.h"
+#include "Effects/ShooterImpactEffectPool.h"
+#include "Player/ShooterLagCompensation.h"
+#include "Weapons/ShooterHitRejectionTelemetry.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Shots Reported"), STAT_ShooterHitscanShotsReported, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Shot Batches Sent"), STAT_ShooterHitscanShotBatches, STATGROUP_ShooterGame);
+
+static int32 MeasureHitscanRPC = 0;
+FAutoConsoleVariableRef CVarMeasureHitscanRPC(
+	TEXT("ShooterGame.MeasureHitscanRPC"),
+	MeasureHitscanRPC,
+	TEXT("Measure payload of reported hitscan shots, both batched and as the old per shot RPCs.\n")
+	TEXT("Results are printed by ShooterGame.DumpHitscanRPCStats"),
+	ECVF_Default);
+
+/** payload totals collected while ShooterGame.MeasureHitscanRPC is on */
+struct FShooterHitscanRPCStats
+{
+	int64 NumShots = 0;
+	int64 NumBatches = 0;
+	int64 LegacyBits = 0;
+	int64 BatchBits = 0;
+};
+static FShooterHitscanRPCStats HitscanRPCStats;
+
+FAutoConsoleCommand ShooterDumpHitscanRPCStatsCmd(TEXT("ShooterGame.DumpHitscanRPCStats"), TEXT("Prints measured hitscan RPC payload per shot, pass 'reset' to clear"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FShooterHitscanRPCStats& Stats = HitscanRPCStats;
+		if (Stats.NumShots > 0)
+		{
+			UE_LOG(LogShooterWeapon, Log, TEXT("Hitscan RPC: %lld shots in %lld batches (%.2f shots per RPC)"), Stats.NumShots, Stats.NumBatches, (float)Stats.NumShots / FMath::Max<int64>(1, Stats.NumBatches));
+			UE_LOG(LogShooterWeapon, Log, TEXT("  per shot RPCs: %.2f bytes per shot"), Stats.LegacyBits / 8.0f / Stats.NumShots);
+			UE_LOG(LogShooterWeapon, Log, TEXT("  batched RPC:   %.2f bytes per shot"), Stats.BatchBits / 8.0f / Stats.NumShots);
+			UE_LOG(LogShooterWeapon, Log, TEXT("  (payload only, batching also saves the RPC header of every shot but the first)"));
+		}
+		else
+		{
+			UE_LOG(LogShooterWeapon, Log, TEXT("Hitscan RPC: nothing measured, set ShooterGame.MeasureHitscanRPC 1 on a client and fire"));
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			HitscanRPCStats = FShooterHitscanRPCStats();
+		}
+	})
+);
+
+static int32 ReplicateImpactRecords = 1;
+FAutoConsoleVariableRef CVarReplicateImpactRecords(
+	TEXT("ShooterGame.ReplicateImpactRecords"),
+	ReplicateImpactRecords,
+	TEXT("How hitscan shots are replicated to remote clients.\n")
+	TEXT("0: origin, seed and spread, remote clients trace the shot again\n")
+	TEXT("1: end point, surface type and normal, remote clients don't trace"),
+	ECVF_Default);
+
+uint32 FInstantHitInfo::EncodeNormal(const FVector& Normal)
+{
+	// project on the octahedron, fold the lower half over the upper one
+	const FVector N = Normal.GetSafeNormal(SMALL_NUMBER, FVector::UpVector);
+	const float L1 = FMath::Abs(N.X) + FMath::Abs(N.Y) + FMath::Abs(N.Z);
+	float U = N.X / L1;
+	float V = N.Y / L1;
+	if (N.Z < 0.0f)
+	{
+		const float FoldedU = (1.0f - FMath::Abs(V)) * (U >= 0.0f ? 1.0f : -1.0f);
+		V = (1.0f - FMath::Abs(U)) * (V >= 0.0f ? 1.0f : -1.0f);
+		U = FoldedU;
+	}
+
+	const uint32 PackedU = (uint32)FMath::Clamp(FMath::RoundToInt((U * 0.5f + 0.5f) * 1023.0f), 0, 1023);
+	const uint32 PackedV = (uint32)FMath::Clamp(FMath::RoundToInt((V * 0.5f + 0.5f) * 1023.0f), 0, 1023);
+	return PackedU | (PackedV << 10);
+}
+
+FVector FInstantHitInfo::DecodeNormal(uint32 Packed)
+{
+	const float U = (Packed & 1023) / 1023.0f * 2.0f - 1.0f;
+	const float V = ((Packed >> 10) & 1023) / 1023.0f * 2.0f - 1.0f;
+
+	FVector N(U, V, 1.0f - FMath::Abs(U) - FMath::Abs(V));
+	if (N.Z < 0.0f)
+	{
+		N.X = (1.0f - FMath::Abs(V)) * (U >= 0.0f ? 1.0f : -1.0f);
+		N.Y = (1.0f - FMath::Abs(U)) * (V >= 0.0f ? 1.0f : -1.0f);
+	}
+
+	return N.GetSafeNormal();
+}
+
+bool FInstantHitInfo::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 Flags = (bImpactRecord ? 1 : 0) | (bImpact ? 2 : 0);
+	Ar.SerializeBits(&Flags, 2);
+	bImpactRecord = (Flags & 1) != 0;
+	bImpact = (Flags & 2) != 0;
+
+	bOutSuccess = true;
+	if (bImpactRecord)
+	{
+		bOutSuccess &= SerializePackedVector<10, 24>(EndPoint, Ar);
+		if (bImpact)
+		{
+			Ar << SurfaceType;
+
+			uint32 PackedNormal = EncodeNormal(ImpactNormal);
+			Ar.SerializeInt(PackedNormal, 1 << 20);
+			ImpactNormal = DecodeNormal(PackedNormal);
+		}
+	}
+	else
+	{
+		// old path, same data as the replicated properties
+		Ar << Origin;
+		Ar << RandomSeed;
+		Ar << ReticleSpread;
+
+		uint8 ExtraPellets = (uint8)FMath::Clamp<int32>(NumPellets - 1, 0, FShooterPelletVolley::MaxPellets - 1);
+		Ar.SerializeBits(&ExtraPellets, 4);
+		NumPellets = ExtraPellets + 1;
+	}
+
+	return true;
+}
+
+bool FInstantHitInfo::operator==(const FInstantHitInfo& Other) const
+{
+	// seed tells shots apart when the rest matches
+	return RandomSeed == Other.RandomSeed && bImpactRecord == Other.bImpactRecord && bImpact == Other.bImpact
+		&& Origin == Other.Origin && ReticleSpread == Other.ReticleSpread && NumPellets == Other.NumPellets
+		&& EndPoint == Other.EndPoint && ImpactNormal == Other.ImpactNormal && SurfaceType == Other.SurfaceType;
+}
+
+FShooterShotRecord::FShooterShotRecord(const FHitResult& Impact, const FVector& InShootDir, int32 InRandomSeed, float InReticleSpread, float InFireTimeOffset)
+	: HitActor(Impact.GetActor())
+	, ImpactPoint(Impact.ImpactPoint)
+	, ImpactNormal(Impact.ImpactNormal)
+	, ShootDir(InShootDir)
+	, BoneIndex(INDEX_NONE)
+	, RandomSeed(InRandomSeed)
+	, ReticleSpread(InReticleSpread)
+	, FireTimeOffset(InFireTimeOffset)
+	, bBlockingHit(Impact.bBlockingHit)
+{
+	// bone index is smaller on the wire than the name
+	const USkinnedMeshComponent* SkinnedMesh = Cast<USkinnedMeshComponent>(Impact.GetComponent());
+	if (SkinnedMesh && Impact.BoneName != NAME_None)
+	{
+		BoneIndex = SkinnedMesh->GetBoneIndex(Impact.BoneName);
+	}
+}
+
+FHitResult FShooterShotRecord::ToHitResult(const FVector& Origin) const
+{
+	FHitResult Hit(HitActor, nullptr, ImpactPoint, ImpactNormal);
+	Hit.bBlockingHit = bBlockingHit;
+	Hit.ImpactPoint = ImpactPoint;
+	Hit.TraceStart = Origin;
+	Hit.TraceEnd = ImpactPoint;
+	Hit.Distance = FVector::Dist(Origin, ImpactPoint);
+
+	if (HitActor)
+	{
+		ACharacter* HitCharacter = Cast<ACharacter>(HitActor);
+		UPrimitiveComponent* HitComponent = HitCharacter ? HitCharacter->GetMesh() : Cast<UPrimitiveComponent>(HitActor->GetRootComponent());
+		if (HitCharacter && BoneIndex != INDEX_NONE)
+		{
+			Hit.BoneName = HitCharacter->GetMesh()->GetBoneName(BoneIndex);
+		}
+
+		Hit.Component = HitComponent;
+		if (FBodyInstance* BodyInstance = HitComponent ? HitComponent->GetBodyInstance(Hit.BoneName) : nullptr)
+		{
+			Hit.PhysMaterial = BodyInstance->GetSimplePhysicalMaterial();
+		}
+	}
+
+	return Hit;
+}
+
+bool FShooterShotRecord::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	// blocking hit, actor and bone flags first, then only what they need
+	uint8 Flags = (bBlockingHit ? 1 : 0) | (HitActor ? 2 : 0) | (BoneIndex != INDEX_NONE ? 4 : 0);
+	Ar.SerializeBits(&Flags, 3);
+	bBlockingHit = (Flags & 1) != 0;
+
+	bOutSuccess = SerializeFixedVector<1, 16>(ShootDir, Ar);
+
+	if (bBlockingHit)
+	{
+		bOutSuccess &= SerializePackedVector<10, 24>(ImpactPoint, Ar);
+		bOutSuccess &= SerializeFixedVector<1, 8>(ImpactNormal, Ar);
+	}
+	else if (Ar.IsLoading())
+	{
+		ImpactPoint = FVector::ZeroVector;
+		ImpactNormal = FVector::ZeroVector;
+	}
+
+	UObject* HitObject = HitActor;
+	if (Flags & 2)
+	{
+		bOutSuccess &= Map && Map->SerializeObject(Ar, AActor::StaticClass(), HitObject);
+	}
+	if (Ar.IsLoading())
+	{
+		HitActor = (Flags & 2) ? Cast<AActor>(HitObject) : nullptr;
+	}
+
+	uint32 PackedBone = (Flags & 4) ? (uint32)BoneIndex : 0;
+	if (Flags & 4)
+	{
+		Ar.SerializeIntPacked(PackedBone);
+	}
+	if (Ar.IsLoading())
+	{
+		BoneIndex = (Flags & 4) ? (int32)PackedBone : INDEX_NONE;
+	}
+
+	uint32 PackedSeed = (uint32)RandomSeed;
+	Ar.SerializeIntPacked(PackedSeed);
+	RandomSeed = (int32)PackedSeed;
+
+	// hundredths of a degree, rounded up so the server never checks against a tighter cone
+	uint16 PackedSpread = (uint16)FMath::Clamp(FMath::CeilToInt(ReticleSpread * 100.0f), 0, MAX_uint16);
+	Ar << PackedSpread;
+	ReticleSpread = PackedSpread / 100.0f;
+
+	// milliseconds, 0 for all but the catch up shots of a frame
+	uint32 PackedOffset = (uint32)FMath::Clamp(FMath::RoundToInt(FireTimeOffset * 1000.0f), 0, (int32)MAX_uint16);
+	Ar.SerializeIntPacked(PackedOffset);
+	FireTimeOffset = PackedOffset / 1000.0f;
+
+	return true;
+}
 
 AShooterWeapon_Instant::AShooterWeapon_Instant(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	CurrentFiringSpread = 0.0f;
+	PendingShotsFireTime = 0.0f;
+	TrailFXPool = FShooterWeaponFXPool(8);
+	NextVolleyId = 0;
+	DamageBatchDepth = 0;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -21,34 +262,73 @@ void AShooterWeapon_Instant::FireWeapon()
 	const float ConeHalfAngle = FMath::DegreesToRadians(CurrentSpread * 0.5f);
 
 	const FVector AimDir = GetAdjustedAim();
-	const FVector StartTrace = GetCameraDamageStartLocation(AimDir);
-	const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
-	const FVector EndTrace = StartTrace + ShootDir * InstantConfig.WeaponRange;
 
-	const FHitResult Impact = WeaponTrace(StartTrace, EndTrace);
-	ProcessInstantHit(Impact, StartTrace, ShootDir, RandomSeed, CurrentSpread);
+	// a catch up shot was due earlier in the frame, trace from where the shooter was back then
+	const float ShotAge = GetShotAge();
+	const FVector StartTrace = GetCameraDamageStartLocation(AimDir) - (MyPawn ? MyPawn->GetVelocity() * ShotAge : FVector::ZeroVector);
+
+	const FInstantWeaponData& Stats = GetInstantStats();
+	if (Stats.PelletCount > 1)
+	{
+		FirePellets(StartTrace, AimDir, RandomSeed, CurrentSpread, FMath::Min(Stats.PelletCount, FShooterPelletVolley::MaxPellets));
+	}
+	else
+	{
+		const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
+		const FVector EndTrace = StartTrace + ShootDir * Stats.WeaponRange;
+
+		const FHitResult Impact = WeaponTrace(StartTrace, EndTrace);
+		ProcessInstantHit(Impact, StartTrace, ShootDir, RandomSeed, CurrentSpread);
+	}
 
-	CurrentFiringSpread = FMath::Min(InstantConfig.FiringSpreadMax, CurrentFiringSpread + InstantConfig.FiringSpreadIncrement);
+	CurrentFiringSpread = FMath::Min(Stats.FiringSpreadMax, CurrentFiringSpread + Stats.FiringSpreadIncrement);
 }
 
-bool AShooterWeapon_Instant::ServerNotifyHit_Validate(const FHitResult& Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
+bool AShooterWeapon_Instant::ServerNotifyShots_Validate(const TArray<FShooterShotRecord>& Shots, float ClientFireTime)
 {
-	return true;
+	// one client frame can't hold more shots than this
+	return Shots.Num() > 0 && Shots.Num() <= MaxShotsPerBatch;
 }
 
-void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult& Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
+void AShooterWeapon_Instant::ServerNotifyShots_Implementation(const TArray<FShooterShotRecord>& Shots, float ClientFireTime)
+{
+	if (GetInstigator() == nullptr)
+	{
+		return;
+	}
+
+	// shared by every shot of the batch
+	const FVector Origin = GetMuzzleLocation();
+	const FVector ViewDir = GetInstigator()->GetViewRotation().Vector();
+
+	// pellets of a shot hitting the same pawn are one damage event
+	BeginDamageBatch();
+	for (const FShooterShotRecord& Shot : Shots)
+	{
+		if (Shot.bBlockingHit)
+		{
+			ServerVerifyHit(Shot.ToHitResult(Origin), Origin, ViewDir, Shot.ShootDir, Shot.RandomSeed, Shot.ReticleSpread, ClientFireTime - Shot.FireTimeOffset);
+		}
+		else
+		{
+			ServerProcessMiss(Origin, Shot.ShootDir, Shot.RandomSeed, Shot.ReticleSpread);
+		}
+	}
+	FlushDamageBatch();
+}
+
+void AShooterWeapon_Instant::ServerVerifyHit(const FHitResult& Impact, const FVector& Origin, const FVector& ViewDir, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread, float ClientFireTime)
 {
 	const float WeaponAngleDot = FMath::Abs(FMath::Sin(ReticleSpread * PI / 180.f));
 
-	// if we have an instigator, calculate dot between the view and the shot
-	if (GetInstigator() && (Impact.GetActor() || Impact.bBlockingHit))
+	// calculate dot between the view and the shot
+	if (Impact.GetActor() || Impact.bBlockingHit)
 	{
-		const FVector Origin = GetMuzzleLocation();
-		const FVector ViewDir = (Impact.Location - Origin).GetSafeNormal();
+		const FVector HitDir = (Impact.Location - Origin).GetSafeNormal();
 
 		// is the angle between the hit and the view within allowed limits (limit + weapon max angle)
-		const float ViewDotHitDir = FVector::DotProduct(GetInstigator()->GetViewRotation().Vector(), ViewDir);
-		if (ViewDotHitDir > InstantConfig.AllowedViewDotHitDir - WeaponAngleDot)
+		const float ViewDotHitDir = FVector::DotProduct(ViewDir, HitDir);
+		if (ViewDotHitDir > GetInstantStats().AllowedViewDotHitDir - WeaponAngleDot)
 		{
 			if (CurrentState != EWeaponState::Idle)
 			{
@@ -65,66 +345,100 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult& Im
 				{
 					ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
 				}
-				else
+				else if (AShooterCharacter* HitPawn = Cast<AShooterCharacter>(Impact.GetActor()))
 				{
-					// Get the component bounding box
-					const FBox HitBox = Impact.GetActor()->GetComponentsBoundingBox();
-
-					// calculate the box extent, and increase by a leeway
-					FVector BoxExtent = 0.5 * (HitBox.Max - HitBox.Min);
-					BoxExtent *= InstantConfig.ClientSideHitLeeway;
-
-					// avoid precision errors with really thin objects
-					BoxExtent.X = FMath::Max(20.0f, BoxExtent.X);
-					BoxExtent.Y = FMath::Max(20.0f, BoxExtent.Y);
-					BoxExtent.Z = FMath::Max(20.0f, BoxExtent.Z);
-
-					// Get the box center
-					const FVector BoxCenter = (HitBox.Min + HitBox.Max) * 0.5;
-
-					// if we are within client tolerance
-					if (FMath::Abs(Impact.Location.Z - BoxCenter.Z) < BoxExtent.Z &&
-						FMath::Abs(Impact.Location.X - BoxCenter.X) < BoxExtent.X &&
-						FMath::Abs(Impact.Location.Y - BoxCenter.Y) < BoxExtent.Y)
+					// check against where the pawn was when the client fired
+					UShooterLagCompensation* LagCompensation = GetWorld()->GetSubsystem<UShooterLagCompensation>();
+					FVector HitboxCenter, HitboxExtent;
+					if (LagCompensation && LagCompensation->GetHitboxAtTime(HitPawn, ClientFireTime, HitboxCenter, HitboxExtent))
 					{
-						ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
+						HitboxExtent += FVector(GetInstantStats().LagCompensationLeeway);
+						if (FMath::Abs(Impact.Location.Z - HitboxCenter.Z) < HitboxExtent.Z &&
+							FMath::Abs(Impact.Location.X - HitboxCenter.X) < HitboxExtent.X &&
+							FMath::Abs(Impact.Location.Y - HitboxCenter.Y) < HitboxExtent.Y)
+						{
+							ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
+						}
+						else
+						{
+							RejectHit(EShooterHitRejection::RewoundHitbox, GetBoxError(Impact.Location, HitboxCenter, HitboxExtent), -1.0f);
+						}
 					}
 					else
 					{
-						UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (outside bounding box tolerance)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
+						ValidateHitAgainstBounds(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
 					}
 				}
+				else
+				{
+					ValidateHitAgainstBounds(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
+				}
 			}
 		}
-		else if (ViewDotHitDir <= InstantConfig.AllowedViewDotHitDir)
-		{
-			UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (facing too far from the hit direction)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
-		}
 		else
 		{
-			UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
+			// degrees past the widest accepted angle
+			const float AllowedAngle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(GetInstantStats().AllowedViewDotHitDir - WeaponAngleDot, -1.0f, 1.0f)));
+			const float HitAngle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(ViewDotHitDir, -1.0f, 1.0f)));
+			RejectHit(EShooterHitRejection::ViewAngle, -1.0f, FMath::Max(0.0f, HitAngle - AllowedAngle));
 		}
 	}
 }
 
-bool AShooterWeapon_Instant::ServerNotifyMiss_Validate(FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
+void AShooterWeapon_Instant::ValidateHitAgainstBounds(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread)
 {
-	return true;
+	// Get the component bounding box
+	const FBox HitBox = Impact.GetActor()->GetComponentsBoundingBox();
+
+	// calculate the box extent, and increase by a leeway
+	FVector BoxExtent = 0.5 * (HitBox.Max - HitBox.Min);
+	BoxExtent *= GetInstantStats().ClientSideHitLeeway;
+
+	// avoid precision errors with really thin objects
+	BoxExtent.X = FMath::Max(20.0f, BoxExtent.X);
+	BoxExtent.Y = FMath::Max(20.0f, BoxExtent.Y);
+	BoxExtent.Z = FMath::Max(20.0f, BoxExtent.Z);
+
+	// Get the box center
+	const FVector BoxCenter = (HitBox.Min + HitBox.Max) * 0.5;
+
+	// if we are within client tolerance
+	if (FMath::Abs(Impact.Location.Z - BoxCenter.Z) < BoxExtent.Z &&
+		FMath::Abs(Impact.Location.X - BoxCenter.X) < BoxExtent.X &&
+		FMath::Abs(Impact.Location.Y - BoxCenter.Y) < BoxExtent.Y)
+	{
+		ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
+	}
+	else
+	{
+		RejectHit(EShooterHitRejection::Bounds, GetBoxError(Impact.Location, BoxCenter, BoxExtent), -1.0f);
+	}
 }
 
-void AShooterWeapon_Instant::ServerNotifyMiss_Implementation(FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
+void AShooterWeapon_Instant::RejectHit(EShooterHitRejection Reason, float DistanceError, float AngleError)
 {
-	const FVector Origin = GetMuzzleLocation();
+	UShooterHitRejectionTelemetry* Telemetry = GetWorld()->GetSubsystem<UShooterHitRejectionTelemetry>();
+	if (Telemetry)
+	{
+		Telemetry->RecordRejection(Cast<APlayerController>(GetInstigatorController()), Reason, DistanceError, AngleError);
+	}
+}
+
+float AShooterWeapon_Instant::GetBoxError(const FVector& Location, const FVector& BoxCenter, const FVector& BoxExtent)
+{
+	const FVector Offset = (Location - BoxCenter).GetAbs() - BoxExtent;
+	return FVector(FMath::Max(0.0f, Offset.X), FMath::Max(0.0f, Offset.Y), FMath::Max(0.0f, Offset.Z)).Size();
+}
 
+void AShooterWeapon_Instant::ServerProcessMiss(const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread)
+{
 	// play FX on remote clients
-	HitNotify.Origin = Origin;
-	HitNotify.RandomSeed = RandomSeed;
-	HitNotify.ReticleSpread = ReticleSpread;
+	SetHitNotify(FHitResult(ForceInit), Origin, ShootDir, RandomSeed, ReticleSpread);
 
 	// play FX locally
 	if (GetNetMode() != NM_DedicatedServer)
 	{
-		const FVector EndTrace = Origin + ShootDir * InstantConfig.WeaponRange;
+		const FVector EndTrace = Origin + ShootDir * GetInstantStats().WeaponRange;
 		SpawnTrailEffect(EndTrace);
 	}
 }
@@ -133,24 +447,11 @@ void AShooterWeapon_Instant::ProcessInstantHit(const FHitResult& Impact, const F
 {
 	if (MyPawn && MyPawn->IsLocallyControlled() && GetNetMode() == NM_Client)
 	{
-		// if we're a client and we've hit something that is being controlled by the server
-		if (Impact.GetActor() && Impact.GetActor()->GetRemoteRole() == ROLE_Authority)
+		// if we're a client and we've hit something that is being controlled by the server, or hit / missed the world
+		if ((Impact.GetActor() && Impact.GetActor()->GetRemoteRole() == ROLE_Authority) || Impact.GetActor() == NULL)
 		{
-			// notify the server of the hit
-			ServerNotifyHit(Impact, ShootDir, RandomSeed, ReticleSpread);
-		}
-		else if (Impact.GetActor() == NULL)
-		{
-			if (Impact.bBlockingHit)
-			{
-				// notify the server of the hit
-				ServerNotifyHit(Impact, ShootDir, RandomSeed, ReticleSpread);
-			}
-			else
-			{
-				// notify server of the miss
-				ServerNotifyMiss(ShootDir, RandomSeed, ReticleSpread);
-			}
+			// notify the server with the other shots of this frame
+			QueueShotForServer(Impact, ShootDir, RandomSeed, ReticleSpread);
 		}
 	}
 
@@ -158,6 +459,107 @@ void AShooterWeapon_Instant::ProcessInstantHit(const FHitResult& Impact, const F
 	ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
 }
 
+void AShooterWeapon_Instant::QueueShotForServer(const FHitResult& Impact, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread)
+{
+	if (PendingShots.Num() == 0)
+	{
+		// shots of a frame are timed from the frame's fire time, send them once the frame is done
+		PendingShotsFireTime = UShooterLagCompensation::GetClientFireTime(GetWorld());
+		TimerHandle_FlushPendingShots = GetWorldTimerManager().SetTimerForNextTick(this, &AShooterWeapon_Instant::FlushPendingShots);
+	}
+	else if (PendingShots.Num() >= MaxShotsPerBatch)
+	{
+		FlushPendingShots();
+		QueueShotForServer(Impact, ShootDir, RandomSeed, ReticleSpread);
+		return;
+	}
+
+	PendingShots.Emplace(Impact, ShootDir, RandomSeed, ReticleSpread, GetShotAge());
+
+	UNetConnection* Connection = MeasureHitscanRPC ? GetNetConnection() : nullptr;
+	if (Connection && Connection->PackageMap)
+	{
+		// what ServerNotifyHit / ServerNotifyMiss used to send for this shot
+		FNetBitWriter Writer(Connection->PackageMap, 0);
+		bool bSuccess = true;
+		FVector_NetQuantizeNormal QuantizedDir = ShootDir;
+		int32 Seed = RandomSeed;
+		float Spread = ReticleSpread;
+		if (Impact.GetActor() || Impact.bBlockingHit)
+		{
+			FHitResult ImpactCopy = Impact;
+			ImpactCopy.NetSerialize(Writer, Connection->PackageMap, bSuccess);
+			float FireTime = PendingShotsFireTime - GetShotAge();
+			Writer << FireTime;
+		}
+		QuantizedDir.NetSerialize(Writer, Connection->PackageMap, bSuccess);
+		Writer << Seed;
+		Writer << Spread;
+
+		HitscanRPCStats.NumShots++;
+		HitscanRPCStats.LegacyBits += Writer.GetNumBits();
+	}
+}
+
+void AShooterWeapon_Instant::StopFire()
+{
+	// ServerStopFire idles the weapon on the server, which then ignores hits arriving after it
+	if (MyPawn && MyPawn->IsLocallyControlled() && GetNetMode() == NM_Client)
+	{
+		FinishPendingVolleys();
+		FlushPendingShots();
+	}
+
+	Super::StopFire();
+}
+
+int32 AShooterWeapon_Instant::GetNumUnsentShots() const
+{
+	int32 NumUnsent = PendingShots.Num();
+	for (const FShooterPelletVolley& Volley : PendingVolleys)
+	{
+		if (!Volley.bSimulated)
+		{
+			NumUnsent += Volley.NumPellets;
+		}
+	}
+	return NumUnsent;
+}
+
+void AShooterWeapon_Instant::FlushPendingShots()
+{
+	GetWorldTimerManager().ClearTimer(TimerHandle_FlushPendingShots);
+	if (PendingShots.Num() == 0)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT_BY(STAT_ShooterHitscanShotsReported, PendingShots.Num());
+	INC_DWORD_STAT(STAT_ShooterHitscanShotBatches);
+
+	UNetConnection* Connection = MeasureHitscanRPC ? GetNetConnection() : nullptr;
+	if (Connection && Connection->PackageMap)
+	{
+		// array count, shots and fire time, same as the RPC parameters
+		FNetBitWriter Writer(Connection->PackageMap, 0);
+		uint16 NumShots = (uint16)PendingShots.Num();
+		Writer << NumShots;
+		bool bSuccess = true;
+		for (FShooterShotRecord& Shot : PendingShots)
+		{
+			Shot.NetSerialize(Writer, Connection->PackageMap, bSuccess);
+		}
+		float FireTime = PendingShotsFireTime;
+		Writer << FireTime;
+
+		HitscanRPCStats.NumBatches++;
+		HitscanRPCStats.BatchBits += Writer.GetNumBits();
+	}
+
+	ServerNotifyShots(PendingShots, PendingShotsFireTime);
+	PendingShots.Reset();
+}
+
 void AShooterWeapon_Instant::ProcessInstantHit_Confirmed(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread)
 {
 	// handle damage
@@ -169,15 +571,13 @@ void AShooterWeapon_Instant::ProcessInstantHit_Confirmed(const FHitResult& Impac
 	// play FX on remote clients
 	if (GetLocalRole() == ROLE_Authority)
 	{
-		HitNotify.Origin = Origin;
-		HitNotify.RandomSeed = RandomSeed;
-		HitNotify.ReticleSpread = ReticleSpread;
+		SetHitNotify(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
 	}
 
 	// play FX locally
 	if (GetNetMode() != NM_DedicatedServer)
 	{
-		const FVector EndTrace = Origin + ShootDir * InstantConfig.WeaponRange;
+		const FVector EndTrace = Origin + ShootDir * GetInstantStats().WeaponRange;
 		const FVector EndPoint = Impact.GetActor() ? Impact.ImpactPoint : EndTrace;
 
 		SpawnTrailEffect(EndPoint);
@@ -185,6 +585,25 @@ void AShooterWeapon_Instant::ProcessInstantHit_Confirmed(const FHitResult& Impac
 	}
 }
 
+void AShooterWeapon_Instant::SetHitNotify(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread)
+{
+	HitNotify.Origin = Origin;
+	HitNotify.RandomSeed = RandomSeed;
+	HitNotify.ReticleSpread = ReticleSpread;
+	HitNotify.NumPellets = (uint8)FMath::Clamp(GetInstantStats().PelletCount, 1, FShooterPelletVolley::MaxPellets);
+
+	// every pellet of a shot sets the same seed, so the shot replicates once and remote clients fire all pellets
+	HitNotify.bImpactRecord = ReplicateImpactRecords != 0 && HitNotify.NumPellets == 1;
+	HitNotify.bImpact = Impact.bBlockingHit;
+
+	if (HitNotify.bImpactRecord)
+	{
+		HitNotify.EndPoint = Impact.bBlockingHit ? Impact.ImpactPoint : Origin + ShootDir * GetInstantStats().WeaponRange;
+		HitNotify.ImpactNormal = Impact.bBlockingHit ? Impact.ImpactNormal : FVector::ZeroVector;
+		HitNotify.SurfaceType = Impact.bBlockingHit ? (uint8)UPhysicalMaterial::DetermineSurfaceType(Impact.PhysMaterial.Get()) : 0;
+	}
+}
+
 bool AShooterWeapon_Instant::ShouldDealDamage(AActor* TestActor) const
 {
 	// if we're an actor on the server, or the actor's role is authoritative, we should register damage
@@ -202,20 +621,240 @@ bool AShooterWeapon_Instant::ShouldDealDamage(AActor* TestActor) const
 }
 
 void AShooterWeapon_Instant::DealDamage(const FHitResult& Impact, const FVector& ShootDir)
+{
+	const float Damage = GetInstantStats().HitDamage;
+	if (DamageBatchDepth == 0)
+	{
+		ApplyPointDamage(Impact, ShootDir, Damage);
+		return;
+	}
+
+	for (FShooterPendingDamage& Pending : PendingDamage)
+	{
+		if (Pending.Victim == Impact.GetActor())
+		{
+			Pending.Damage += Damage;
+			return;
+		}
+	}
+
+	FShooterPendingDamage& Pending = PendingDamage.AddDefaulted_GetRef();
+	Pending.Victim = Impact.GetActor();
+	Pending.Impact = Impact;
+	Pending.ShootDir = ShootDir;
+	Pending.Damage = Damage;
+}
+
+void AShooterWeapon_Instant::ApplyPointDamage(const FHitResult& Impact, const FVector& ShootDir, float Damage)
 {
 	FPointDamageEvent PointDmg;
-	PointDmg.DamageTypeClass = InstantConfig.DamageType;
+	PointDmg.DamageTypeClass = GetInstantStats().DamageType;
 	PointDmg.HitInfo = Impact;
 	PointDmg.ShotDirection = ShootDir;
-	PointDmg.Damage = InstantConfig.HitDamage;
+	PointDmg.Damage = Damage;
+
+	Impact.GetActor()->TakeDamage(PointDmg.Damage, PointDmg, MyPawn ? MyPawn->Controller : nullptr, this);
+}
+
+void AShooterWeapon_Instant::BeginDamageBatch()
+{
+	DamageBatchDepth++;
+}
+
+void AShooterWeapon_Instant::FlushDamageBatch()
+{
+	check(DamageBatchDepth > 0);
+	if (--DamageBatchDepth > 0)
+	{
+		return;
+	}
+
+	// taking damage can end up here again through a kill, work on a copy
+	TArray<FShooterPendingDamage, TInlineAllocator<4>> Damages = MoveTemp(PendingDamage);
+	PendingDamage.Reset();
+	for (const FShooterPendingDamage& Pending : Damages)
+	{
+		if (Pending.Victim.IsValid())
+		{
+			ApplyPointDamage(Pending.Impact, Pending.ShootDir, Pending.Damage);
+		}
+	}
+}
+
+void AShooterWeapon_Instant::FirePellets(const FVector& Origin, const FVector& AimDir, int32 RandomSeed, float ReticleSpread, int32 NumPellets)
+{
+	FShooterPelletVolley& Volley = PendingVolleys.AddDefaulted_GetRef();
+	Volley.Id = NextVolleyId;
+	Volley.Origin = Origin;
+	Volley.RandomSeed = RandomSeed;
+	Volley.ReticleSpread = ReticleSpread;
+	Volley.ShotTime = CurrentShotTime;
+	Volley.NumPellets = NumPellets;
+	Volley.bSimulated = false;
+	GetPelletDirections(AimDir, FMath::DegreesToRadians(ReticleSpread * 0.5f), RandomSeed, NumPellets, Volley.ShootDirs);
+
+	NextVolleyId = (NextVolleyId + 1) & 0x0FFFFFFF;
+	TraceVolley(Volley);
+}
+
+void AShooterWeapon_Instant::GetPelletDirections(const FVector& AimDir, float ConeHalfAngle, int32 RandomSeed, int32 NumPellets, FVector* OutDirs)
+{
+	const int32 MaxPellets = FShooterPelletVolley::MaxPellets;
+	check(NumPellets <= MaxPellets);
+
+	// angle around the aim and angle off the aim of every pellet, uniform over the cone's cap
+	MS_ALIGN(16) float Angles[2][MaxPellets] GCC_ALIGN(16) = {};
+	FRandomStream WeaponRandomStream(RandomSeed);
+	for (int32 PelletIdx = 0; PelletIdx < NumPellets; PelletIdx++)
+	{
+		Angles[0][PelletIdx] = WeaponRandomStream.FRand() * 2.0f * PI;
+		Angles[1][PelletIdx] = FMath::Acos(1.0f - WeaponRandomStream.FRand() * (1.0f - FMath::Cos(ConeHalfAngle)));
+	}
+
+	// sin / cos of four pellets at a time
+	MS_ALIGN(16) float Sines[2][MaxPellets] GCC_ALIGN(16);
+	MS_ALIGN(16) float Cosines[2][MaxPellets] GCC_ALIGN(16);
+	for (int32 Row = 0; Row < 2; Row++)
+	{
+		for (int32 PelletIdx = 0; PelletIdx < NumPellets; PelletIdx += 4)
+		{
+			const VectorRegister VAngles = VectorLoadAligned(&Angles[Row][PelletIdx]);
+			VectorRegister VSines, VCosines;
+			VectorSinCos(&VSines, &VCosines, &VAngles);
+			VectorStoreAligned(VSines, &Sines[Row][PelletIdx]);
+			VectorStoreAligned(VCosines, &Cosines[Row][PelletIdx]);
+		}
+	}
+
+	FVector Right, Up;
+	AimDir.FindBestAxisVectors(Right, Up);
+	for (int32 PelletIdx = 0; PelletIdx < NumPellets; PelletIdx++)
+	{
+		const FVector Offset = Right * Cosines[0][PelletIdx] + Up * Sines[0][PelletIdx];
+		OutDirs[PelletIdx] = AimDir * Cosines[1][PelletIdx] + Offset * Sines[1][PelletIdx];
+	}
+}
+
+void AShooterWeapon_Instant::TraceVolley(FShooterPelletVolley& Volley)
+{
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(PelletTrace), true, GetInstigator());
+	TraceParams.bReturnPhysicalMaterial = true;
+
+	FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &AShooterWeapon_Instant::OnPelletTraceDone);
+	const float WeaponRange = GetInstantStats().WeaponRange;
 
-	Impact.GetActor()->TakeDamage(PointDmg.Damage, PointDmg, MyPawn->Controller, this);
+	Volley.NumPending = Volley.NumPellets;
+	for (int32 PelletIdx = 0; PelletIdx < Volley.NumPellets; PelletIdx++)
+	{
+		// volley id and pellet index share the user data
+		const FVector EndTrace = Volley.Origin + Volley.ShootDirs[PelletIdx] * WeaponRange;
+		const uint32 UserData = (Volley.Id << 4) | (uint32)PelletIdx;
+		GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Volley.Origin, EndTrace, COLLISION_WEAPON, TraceParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, UserData);
+	}
+}
+
+void AShooterWeapon_Instant::OnPelletTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceData)
+{
+	const uint32 VolleyId = TraceData.UserData >> 4;
+	const int32 PelletIdx = TraceData.UserData & 15;
+	const int32 VolleyIdx = PendingVolleys.IndexOfByPredicate([VolleyId](const FShooterPelletVolley& Volley) { return Volley.Id == VolleyId; });
+	if (VolleyIdx == INDEX_NONE)
+	{
+		return;
+	}
+
+	FShooterPelletVolley& Volley = PendingVolleys[VolleyIdx];
+	FHitResult& Impact = Volley.Impacts[PelletIdx];
+	if (TraceData.OutHits.Num() > 0)
+	{
+		Impact = TraceData.OutHits[0];
+	}
+	else
+	{
+		Impact = FHitResult(ForceInit);
+		Impact.TraceStart = TraceData.Start;
+		Impact.TraceEnd = TraceData.End;
+	}
+
+	if (--Volley.NumPending == 0)
+	{
+		const FShooterPelletVolley DoneVolley = MoveTemp(Volley);
+		PendingVolleys.RemoveAtSwap(VolleyIdx, 1, false);
+		ProcessVolley(DoneVolley);
+	}
+}
+
+void AShooterWeapon_Instant::FinishPendingVolleys()
+{
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(PelletTrace), true, GetInstigator());
+	TraceParams.bReturnPhysicalMaterial = true;
+	const float WeaponRange = GetInstantStats().WeaponRange;
+
+	// async results of these volleys find no volley anymore and are dropped
+	for (int32 VolleyIdx = PendingVolleys.Num() - 1; VolleyIdx >= 0; VolleyIdx--)
+	{
+		if (PendingVolleys[VolleyIdx].bSimulated)
+		{
+			continue;
+		}
+
+		FShooterPelletVolley Volley = MoveTemp(PendingVolleys[VolleyIdx]);
+		PendingVolleys.RemoveAtSwap(VolleyIdx, 1, false);
+
+		for (int32 PelletIdx = 0; PelletIdx < Volley.NumPellets; PelletIdx++)
+		{
+			const FVector EndTrace = Volley.Origin + Volley.ShootDirs[PelletIdx] * WeaponRange;
+			FHitResult& Impact = Volley.Impacts[PelletIdx];
+			if (!GetWorld()->LineTraceSingleByChannel(Impact, Volley.Origin, EndTrace, COLLISION_WEAPON, TraceParams))
+			{
+				Impact = FHitResult(ForceInit);
+				Impact.TraceStart = Volley.Origin;
+				Impact.TraceEnd = EndTrace;
+			}
+		}
+		ProcessVolley(Volley);
+	}
+}
+
+void AShooterWeapon_Instant::ProcessVolley(const FShooterPelletVolley& Volley)
+{
+	const float WeaponRange = GetInstantStats().WeaponRange;
+	if (Volley.bSimulated)
+	{
+		for (int32 PelletIdx = 0; PelletIdx < Volley.NumPellets; PelletIdx++)
+		{
+			const FHitResult& Impact = Volley.Impacts[PelletIdx];
+			if (Impact.bBlockingHit)
+			{
+				SpawnImpactEffects(Impact);
+				SpawnTrailEffect(Impact.ImpactPoint);
+			}
+			else
+			{
+				SpawnTrailEffect(Volley.Origin + Volley.ShootDirs[PelletIdx] * WeaponRange);
+			}
+		}
+		return;
+	}
+
+	// report pellets with the time the shot was fired, not when the traces came back
+	TGuardValue<float> ShotTimeGuard(CurrentShotTime, Volley.ShotTime);
+
+	BeginDamageBatch();
+	for (int32 PelletIdx = 0; PelletIdx < Volley.NumPellets; PelletIdx++)
+	{
+		ProcessInstantHit(Volley.Impacts[PelletIdx], Volley.Origin, Volley.ShootDirs[PelletIdx], Volley.RandomSeed, Volley.ReticleSpread);
+	}
+	FlushDamageBatch();
 }
 
 void AShooterWeapon_Instant::OnBurstFinished()
 {
 	Super::OnBurstFinished();
 
+	// don't hold the last shots of the burst until next frame
+	FlushPendingShots();
+
 	CurrentFiringSpread = 0.0f;
 }
 
@@ -225,10 +864,10 @@ void AShooterWeapon_Instant::OnBurstFinished()
 
 float AShooterWeapon_Instant::GetCurrentSpread() const
 {
-	float FinalSpread = InstantConfig.WeaponSpread + CurrentFiringSpread;
+	float FinalSpread = GetInstantStats().WeaponSpread + CurrentFiringSpread;
 	if (MyPawn && MyPawn->IsTargeting())
 	{
-		FinalSpread *= InstantConfig.TargetingSpreadMod;
+		FinalSpread *= GetInstantStats().TargetingSpreadMod;
 	}
 
 	return FinalSpread;
@@ -240,7 +879,34 @@ float AShooterWeapon_Instant::GetCurrentSpread() const
 
 void AShooterWeapon_Instant::OnRep_HitNotify()
 {
-	SimulateInstantHit(HitNotify.Origin, HitNotify.RandomSeed, HitNotify.ReticleSpread);
+	if (HitNotify.bImpactRecord)
+	{
+		SimulateImpactRecord(HitNotify);
+	}
+	else if (HitNotify.NumPellets > 1)
+	{
+		SimulatePellets(HitNotify.Origin, HitNotify.RandomSeed, HitNotify.ReticleSpread, HitNotify.NumPellets);
+	}
+	else
+	{
+		SimulateInstantHit(HitNotify.Origin, HitNotify.RandomSeed, HitNotify.ReticleSpread);
+	}
+}
+
+void AShooterWeapon_Instant::SimulatePellets(const FVector& ShotOrigin, int32 RandomSeed, float ReticleSpread, int32 NumPellets)
+{
+	FShooterPelletVolley& Volley = PendingVolleys.AddDefaulted_GetRef();
+	Volley.Id = NextVolleyId;
+	Volley.Origin = ShotOrigin;
+	Volley.RandomSeed = RandomSeed;
+	Volley.ReticleSpread = ReticleSpread;
+	Volley.ShotTime = GetWorld()->GetTimeSeconds();
+	Volley.NumPellets = FMath::Min(NumPellets, FShooterPelletVolley::MaxPellets);
+	Volley.bSimulated = true;
+	GetPelletDirections(GetAdjustedAim(), FMath::DegreesToRadians(ReticleSpread * 0.5f), RandomSeed, Volley.NumPellets, Volley.ShootDirs);
+
+	NextVolleyId = (NextVolleyId + 1) & 0x0FFFFFFF;
+	TraceVolley(Volley);
 }
 
 void AShooterWeapon_Instant::SimulateInstantHit(const FVector& ShotOrigin, int32 RandomSeed, float ReticleSpread)
@@ -251,7 +917,7 @@ void AShooterWeapon_Instant::SimulateInstantHit(const FVector& ShotOrigin, int32
 	const FVector StartTrace = ShotOrigin;
 	const FVector AimDir = GetAdjustedAim();
 	const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
-	const FVector EndTrace = StartTrace + ShootDir * InstantConfig.WeaponRange;
+	const FVector EndTrace = StartTrace + ShootDir * GetInstantStats().WeaponRange;
 
 	FHitResult Impact = WeaponTrace(StartTrace, EndTrace);
 	if (Impact.bBlockingHit)
@@ -265,14 +931,26 @@ void AShooterWeapon_Instant::SimulateInstantHit(const FVector& ShotOrigin, int32
 	}
 }
 
-void AShooterWeapon_Instant::SpawnImpactEffects(const FHitResult& Impact)
+void AShooterWeapon_Instant::SimulateImpactRecord(const FInstantHitInfo& HitInfo)
+{
+	if (HitInfo.bImpact)
+	{
+		FHitResult Impact(nullptr, nullptr, HitInfo.EndPoint, HitInfo.ImpactNormal);
+		Impact.bBlockingHit = true;
+		SpawnImpactEffects(Impact, (EPhysicalSurface)HitInfo.SurfaceType);
+	}
+
+	SpawnTrailEffect(HitInfo.EndPoint);
+}
+
+void AShooterWeapon_Instant::SpawnImpactEffects(const FHitResult& Impact, EPhysicalSurface SurfaceType)
 {
 	if (ImpactTemplate && Impact.bBlockingHit)
 	{
 		FHitResult UseImpact = Impact;
 
-		// trace again to find component lost during replication
-		if (!Impact.Component.IsValid())
+		// trace again to find component lost during replication, unless the surface came with it
+		if (!Impact.Component.IsValid() && SurfaceType == SurfaceType_Max)
 		{
 			const FVector StartTrace = Impact.ImpactPoint + Impact.ImpactNormal * 10.0f;
 			const FVector EndTrace = Impact.ImpactPoint - Impact.ImpactNormal * 10.0f;
@@ -280,11 +958,21 @@ void AShooterWeapon_Instant::SpawnImpactEffects(const FHitResult& Impact)
 			UseImpact = Hit;
 		}
 
+		// pooled and budgeted
+		if (UShooterImpactEffectPool* EffectPool = GetWorld()->GetSubsystem<UShooterImpactEffectPool>())
+		{
+			UseImpact.ImpactPoint = Impact.ImpactPoint;
+			UseImpact.ImpactNormal = Impact.ImpactNormal;
+			EffectPool->SpawnEffect(ImpactTemplate, UseImpact, SurfaceType);
+			return;
+		}
+
 		FTransform const SpawnTransform(Impact.ImpactNormal.Rotation(), Impact.ImpactPoint);
 		AShooterImpactEffect* EffectActor = GetWorld()->SpawnActorDeferred<AShooterImpactEffect>(ImpactTemplate, SpawnTransform);
 		if (EffectActor)
 		{
 			EffectActor->SurfaceHit = UseImpact;
+			EffectActor->SurfaceTypeOverride = SurfaceType;
 			UGameplayStatics::FinishSpawningActor(EffectActor, SpawnTransform);
 		}
 	}
@@ -296,10 +984,12 @@ void AShooterWeapon_Instant::SpawnTrailEffect(const FVector& EndPoint)
 	{
 		const FVector Origin = GetMuzzleLocation();
 
-		UParticleSystemComponent* TrailPSC = UGameplayStatics::SpawnEmitterAtLocation(this, TrailFX, Origin);
+		UParticleSystemComponent* TrailPSC = TrailFXPool.Acquire(this, TrailFX);
 		if (TrailPSC)
 		{
+			TrailPSC->SetWorldLocationAndRotation(Origin, FRotator::ZeroRotator);
 			TrailPSC->SetVectorParameter(TrailTargetParam, EndPoint);
+			TrailPSC->ActivateSystem(true);
 		}
 	}
 }
@@ -4,6 +4,8 @@
 #include "Weapons/ShooterWeapon_Projectile.h"
 #include "Weapons/ShooterProjectile.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles Reused"), STAT_ShooterProjectilesReused, STATGROUP_ShooterGame);
+
 AShooterWeapon_Projectile::AShooterWeapon_Projectile(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 }
@@ -71,19 +73,61 @@ bool AShooterWeapon_Projectile::ServerFireProjectile_Validate(FVector Origin, FV
 
 void AShooterWeapon_Projectile::ServerFireProjectile_Implementation(FVector Origin, FVector_NetQuantizeNormal ShootDir)
 {
+	// reuse a parked projectile of the same class
+	AShooterProjectile* Projectile = nullptr;
+	while (ParkedProjectiles.Num() > 0 && Projectile == nullptr)
+	{
+		AShooterProjectile* Candidate = ParkedProjectiles.Pop(false);
+		if (IsValid(Candidate) && Candidate->IsParked() && Candidate->IsA(GetProjectileStats().ProjectileClass))
+		{
+			Projectile = Candidate;
+		}
+	}
+
+	if (Projectile)
+	{
+		INC_DWORD_STAT(STAT_ShooterProjectilesReused);
+		Projectile->SetInstigator(GetInstigator());
+		Projectile->LaunchProjectile(Origin, ShootDir);
+		return;
+	}
+
 	FTransform SpawnTM(ShootDir.Rotation(), Origin);
-	AShooterProjectile* Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, ProjectileConfig.ProjectileClass, SpawnTM));
+	Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, GetProjectileStats().ProjectileClass, SpawnTM));
 	if (Projectile)
 	{
 		Projectile->SetInstigator(GetInstigator());
 		Projectile->SetOwner(this);
-		Projectile->InitVelocity(ShootDir);
 
 		UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
+		Projectile->LaunchProjectile(Origin, ShootDir);
+	}
+}
+
+void AShooterWeapon_Projectile::ReturnProjectile(AShooterProjectile* Projectile)
+{
+	if (Projectile && !IsPendingKillPending())
+	{
+		ParkedProjectiles.AddUnique(Projectile);
+	}
+}
+
+void AShooterWeapon_Projectile::Destroyed()
+{
+	// flying projectiles destroy themselves once they find the weapon gone
+	for (AShooterProjectile* Projectile : ParkedProjectiles)
+	{
+		if (IsValid(Projectile))
+		{
+			Projectile->Destroy();
+		}
 	}
+	ParkedProjectiles.Empty();
+
+	Super::Destroyed();
 }
 
 void AShooterWeapon_Projectile::ApplyWeaponConfig(FProjectileWeaponData& Data)
 {
-	Data = ProjectileConfig;
+	Data = GetProjectileStats();
 }
@@ -33,6 +33,12 @@ protected:
 public:
 	void Respawn();
 
+	/** pause behavior and path following (e.g. while frozen), the blackboard is kept so resuming continues where it stopped */
+	void SetSuspended(bool bNewSuspended);
+
+	/** is logic currently suspended? */
+	bool IsSuspended() const { return bSuspended; }
+
 	void CheckAmmo(const class AShooterWeapon* CurrentWeapon);
 
 	void SetEnemy(class APawn* InPawn);
@@ -64,6 +70,9 @@ protected:
 	int32 EnemyKeyID;
 	int32 NeedAmmoKeyID;
 
+	/** logic and path following paused by SetSuspended */
+	uint8 bSuspended : 1;
+
 	/** Handle for efficient management of Respawn timer */
 	FTimerHandle TimerHandle_Respawn;
 
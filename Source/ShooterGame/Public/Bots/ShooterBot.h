@@ -13,10 +13,6 @@ class AShooterBot : public AShooterCharacter
 	UPROPERTY(EditAnywhere, Category=Behavior)
 	class UBehaviorTree* BotBehavior;
 
-	/**The current bot controller possing the pawn.*/
-	UPROPERTY()
-	AController* BotController;
-
 	virtual bool IsFirstPerson() const override;
 
 	virtual void FaceRotation(FRotator NewRotation, float DeltaTime = 0.f) override;
@@ -24,20 +20,15 @@ class AShooterBot : public AShooterCharacter
 	/** Handle bot receiving damage.*/
 	virtual void DamageToBot(float DamageTaken, struct FDamageEvent const& DamageEvent, class APawn* PawnInstigator, class AActor* DamageCauser) override;
 
-	/** Handle bot freeze damage.*/
+	/** Handle bot freeze start / end on server.*/
+	virtual void OnStatusEffectChanged(EShooterStatusEffect::Type Effect, bool bActive) override;
+
+	/** Freeze bot, stop its logic.*/
 	void Freeze();
 
-	/** Unfreeze bot. Called when freeze actor destroyed.*/
-	UFUNCTION()
-	void Unfreeze(AActor* DestroyedActor);
+	/** Unfreeze bot, resume its logic.*/
+	void Unfreeze();
 
 	/** Adjust the enemy parameters on bot.*/
 	virtual bool IsEnemyFor(AController* TestPC) const override;
-
-	/** Handle bot shrinking.*/
-	void Shrink();
-
-	/** Handle bot unshrinking. Called when shrink actor destroyed.*/
-	UFUNCTION()
-	void Unshrink(AActor* DestroyedActor);
-};
\ No newline at end of file
+};
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterDecalManager.generated.h"
+
+class UDecalComponent;
+
+/** decal component of a ring and what it's currently showing */
+USTRUCT()
+struct FShooterDecalSlot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UDecalComponent* Decal;
+
+	/** component the decal is attached to, null for decals placed in the world */
+	TWeakObjectPtr<USceneComponent> AttachTarget;
+
+	/** world time to hide the decal, 0 to keep it until overwritten */
+	float ExpireTime;
+
+	/** is the decal shown? */
+	bool bActive;
+
+	/** was it attached when shown? */
+	bool bAttached;
+
+	FShooterDecalSlot()
+		: Decal(nullptr)
+		, ExpireTime(0.0f)
+		, bActive(false)
+		, bAttached(false)
+	{
+	}
+};
+
+/** fixed size ring of decals sharing a material */
+USTRUCT()
+struct FShooterDecalRing
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FShooterDecalSlot> Slots;
+
+	/** slot to use next, the oldest one once the ring is full */
+	int32 Next;
+
+	FShooterDecalRing()
+		: Next(0)
+	{
+	}
+};
+
+//
+// Client side owner of impact and explosion decals, one ring buffer of decal components per material.
+// Once a ring is full new decals take over the oldest component, so the number of decals in the scene stays bounded.
+// Decals on destroyed or ragdolling components are hidden and their slot is reused.
+//
+UCLASS()
+class UShooterDecalManager : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	/** show decal, attached to AttachTo when set, hidden after LifeSpan seconds (if positive) */
+	UDecalComponent* SpawnDecal(UMaterialInterface* DecalMaterial, const FVector& DecalSize, USceneComponent* AttachTo, FName BoneName, const FVector& Location, const FRotator& Rotation, float LifeSpan);
+
+	/** print ring state to the log */
+	void DumpStats() const;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+private:
+
+	/** create a new hidden decal component */
+	UDecalComponent* CreateDecal(UMaterialInterface* DecalMaterial);
+
+	/** hide slot's decal and drop its attachment */
+	void DeactivateSlot(FShooterDecalSlot& Slot);
+
+	/** rings by material */
+	UPROPERTY()
+	TMap<UMaterialInterface*, FShooterDecalRing> Rings;
+
+	/** number of shown decals in all rings */
+	int32 NumActive;
+
+	int32 NumOverwritten;
+
+	int32 NumCleanedUp;
+};
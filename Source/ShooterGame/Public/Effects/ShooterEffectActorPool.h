@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterEffectActorPool.generated.h"
+
+/** called when a pooled effect actor goes back to its pool, with the actor it was attached to */
+DECLARE_DELEGATE_OneParam(FOnPooledEffectReleased, AActor* /* Target */);
+
+USTRUCT()
+struct FShooterPooledEffectActors
+{
+	GENERATED_BODY()
+
+	/** idle actors ready to be attached */
+	UPROPERTY()
+	TArray<AActor*> Actors;
+};
+
+//
+// Server side pool of status effect actors (freeze, shrink), one list per class.
+// Idle actors stay spawned but hidden and detached, so hits never spawn or destroy actors once the pool is warm.
+//
+UCLASS()
+class UShooterEffectActorPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	/** [server] make sure at least Count idle actors of the given class are available */
+	void Prewarm(TSubclassOf<AActor> ActorClass, int32 Count);
+
+	/** [server] take an actor from the pool and attach it to target, it's released automatically after LifeSpan (if positive) */
+	AActor* AcquireAttached(TSubclassOf<AActor> ActorClass, AActor* Target, float LifeSpan, FOnPooledEffectReleased OnReleased = FOnPooledEffectReleased());
+
+	/** [server] detach actor and return it to its pool, triggers its release callback */
+	void Release(AActor* EffectActor);
+
+	/** [server] release all pooled actors attached to target */
+	void ReleaseAllAttachedTo(AActor* Target);
+
+	/** number of acquires served by an idle actor */
+	int32 GetNumHits() const { return NumHits; }
+
+	/** number of acquires that had to spawn a new actor */
+	int32 GetNumMisses() const { return NumMisses; }
+
+	/** total number of actors spawned by the pool, prewarm included */
+	int32 GetNumGrowth() const { return NumGrowth; }
+
+	/** print pool state to the log */
+	void DumpStats() const;
+
+private:
+
+	/** bookkeeping for an actor currently attached to a target */
+	struct FActiveEffectActor
+	{
+		TWeakObjectPtr<AActor> Target;
+		FTimerHandle TimerHandle_Release;
+		FOnPooledEffectReleased OnReleased;
+	};
+
+	/** spawn a new hidden actor for the pool */
+	AActor* SpawnPooledActor(UClass* ActorClass);
+
+	/** hide actor and stop it from colliding / ticking while idle */
+	static void SetPooledActorActive(AActor* EffectActor, bool bActive);
+
+	/** idle actors per class */
+	UPROPERTY()
+	TMap<UClass*, FShooterPooledEffectActors> FreeActors;
+
+	/** actors currently in use */
+	TMap<TWeakObjectPtr<AActor>, FActiveEffectActor> ActiveActors;
+
+	int32 NumHits;
+
+	int32 NumMisses;
+
+	int32 NumGrowth;
+};
@@ -94,11 +94,50 @@ class AShooterImpactEffect : public AActor
 	UPROPERTY(BlueprintReadOnly, Category=Surface)
 	FHitResult SurfaceHit;
 
+	/** surface type to use instead of SurfaceHit's physical material, SurfaceType_Max if none */
+	UPROPERTY(BlueprintReadOnly, Category=Surface)
+	TEnumAsByte<EPhysicalSurface> SurfaceTypeOverride;
+
 	/** spawn effect */
 	virtual void PostInitializeComponents() override;
 
+	/** play particles, sound and decal for SurfaceHit at the actor's location */
+	void PlayEffect();
+
+	/** stop particles and sound right away */
+	void StopEffect();
+
+	/** are particles or sound still playing? */
+	bool IsEffectPlaying() const { return bParticlesPlaying || bSoundPlaying; }
+
+	/** world time of the last PlayEffect */
+	float GetLastPlayTime() const { return LastPlayTime; }
+
+	/** owned by UShooterImpactEffectPool, played on demand and never auto destroyed */
+	uint8 bPooled : 1;
+
 protected:
 
+	/** particles of the surface, reused by pooled actors */
+	UPROPERTY(VisibleDefaultsOnly, Category=Visual)
+	UParticleSystemComponent* ParticleComp;
+
+	/** sound of the surface, reused by pooled actors */
+	UPROPERTY(VisibleDefaultsOnly, Category=Sound)
+	UAudioComponent* AudioComp;
+
+	uint8 bParticlesPlaying : 1;
+
+	uint8 bSoundPlaying : 1;
+
+	float LastPlayTime;
+
+	UFUNCTION()
+	void OnParticlesFinished(UParticleSystemComponent* FinishedComponent);
+
+	UFUNCTION()
+	void OnSoundFinished();
+
 	/** get FX for material type */
 	UParticleSystem* GetImpactFX(TEnumAsByte<EPhysicalSurface> SurfaceType) const;
 
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterImpactEffectPool.generated.h"
+
+class AShooterImpactEffect;
+
+//
+// Client side pool of weapon impact effects, one free list per effect class and surface type.
+// Idle actors keep their particle and audio components with the surface's templates set, so an impact only moves and replays them.
+// New impacts are dropped when over the per frame or global budget, or too far from every local viewer.
+//
+UCLASS()
+class UShooterImpactEffectPool : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	/** play impact effect of the given class for the hit, SurfaceType_Max takes the surface from the hit's physical material */
+	AShooterImpactEffect* SpawnEffect(TSubclassOf<AShooterImpactEffect> EffectClass, const FHitResult& Impact, EPhysicalSurface SurfaceType);
+
+	/** print pool state to the log */
+	void DumpStats() const;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/** effects still playing after this long are stopped and returned to the pool */
+	static const float MaxEffectLifeSpan;
+
+private:
+
+	/** free list key */
+	typedef TPair<UClass*, uint8> FEffectKey;
+
+	/** is location close enough to any local viewer? */
+	bool IsInCullDistance(const FVector& Location) const;
+
+	/** hide effect and add it to its free list */
+	void ReturnToPool(AShooterImpactEffect* Effect);
+
+	/** all actors spawned by the pool */
+	UPROPERTY()
+	TArray<AShooterImpactEffect*> PooledEffects;
+
+	/** effects currently playing */
+	UPROPERTY()
+	TArray<AShooterImpactEffect*> ActiveEffects;
+
+	/** idle effects per class and surface type */
+	TMap<FEffectKey, TArray<AShooterImpactEffect*>> FreeEffects;
+
+	/** frame of the last spawn, for the per frame budget */
+	uint64 SpawnFrame;
+
+	/** effects spawned in SpawnFrame */
+	int32 NumSpawnedThisFrame;
+
+	int32 NumHits;
+
+	int32 NumMisses;
+
+	int32 NumDroppedBudget;
+
+	int32 NumDroppedDistance;
+};
@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GameFramework/Info.h"
+#include "ShooterBenchmarkDirector.generated.h"
+
+class UNetConnection;
+class AShooterWeapon;
+
+//
+// Status effect stress benchmark, spawned by AShooterGameMode when the map URL has ?Benchmark=<seconds>.
+// Gives every bot a freeze or shrink launcher, keeps it shooting at the closest bot, and writes one CSV row per server frame:
+// frame time, actors spawned, garbage collection time, bytes sent to connections and how many bots are armed.
+// Bytes sent are only measured with clients connected, the columns say n/a otherwise.
+// Example: ShooterServer Highrise?Benchmark=120?Bots=32 -nullrhi -unattended
+//
+UCLASS()
+class AShooterBenchmarkDirector : public AInfo
+{
+	GENERATED_UCLASS_BODY()
+
+	/** bots spawned when the URL doesn't say how many */
+	static const int32 DefaultNumBots = 16;
+
+	/** start recording, ends the benchmark after Duration seconds */
+	void StartBenchmark(int32 Duration);
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+protected:
+
+	/** arm bots with freeze / shrink weapons, keep their ammo up and give them a target */
+	void UpdateBots();
+
+	/** effect weapon of the kind the bot should shoot, given to it if its inventory has none */
+	AShooterWeapon* GiveEffectWeapon(AShooterCharacter* BotPawn, bool bWantsFreeze);
+
+	/** closest living bot pawn other than BotPawn, effects and teams don't matter */
+	AShooterCharacter* FindTarget(const AShooterCharacter* BotPawn) const;
+
+	/** write the stats of this frame */
+	void RecordFrame(float DeltaSeconds);
+
+	/** close the CSV, log summary and exit when running standalone */
+	void FinishBenchmark();
+
+	/** stop listening to engine events and close the CSV */
+	void StopRecording();
+
+	void OnActorSpawned(AActor* Actor);
+
+	void OnPreGarbageCollect();
+
+	void OnPostGarbageCollect();
+
+	/** launchers handed to the bots */
+	UPROPERTY()
+	TSubclassOf<AShooterWeapon> FreezeWeaponClass;
+
+	UPROPERTY()
+	TSubclassOf<AShooterWeapon> ShrinkWeaponClass;
+
+	/** CSV being written, null when not recording */
+	FArchive* CsvFile;
+
+	/** world time when the benchmark ends */
+	float EndTime;
+
+	/** handle for the periodic bot update */
+	FTimerHandle TimerHandle_UpdateBots;
+
+	FDelegateHandle OnActorSpawnedHandle;
+	FDelegateHandle OnPreGarbageCollectHandle;
+	FDelegateHandle OnPostGarbageCollectHandle;
+
+	/** counters of the current frame */
+	int32 FrameSpawns;
+	double FrameGCSeconds;
+	double GCStartTime;
+
+	/** living bots shooting an effect weapon / without one, as of the last bot update */
+	int32 ArmedBots;
+	int32 SkippedBots;
+
+	/** OutBytes of each connection at the last frame, the connection resets it every stat period */
+	TMap<TWeakObjectPtr<UNetConnection>, int32> LastOutBytes;
+
+	/** totals for the summary */
+	int32 NumFrames;
+	double TotalFrameSeconds;
+	double MaxFrameSeconds;
+	int32 TotalSpawns;
+	double TotalGCSeconds;
+	int64 TotalOutBytes;
+	int32 MaxSkippedBots;
+
+	/** a frame had client connections, bytes sent are measured */
+	bool bMeasuredOutBytes;
+};
@@ -9,6 +9,7 @@
 class AShooterAIController;
 class AShooterPlayerState;
 class AShooterPickup;
+class AShooterBenchmarkDirector;
 class FUniqueNetId;
 
 UCLASS(config=Game)
@@ -34,6 +35,9 @@ class AShooterGameMode : public AGameMode
 	/** starts match warmup */
 	virtual void PostLogin(APlayerController* NewPlayer) override;
 
+	/** sends weapon stats reloaded on the server to joining and travelling players */
+	virtual void GenericPlayerInitialization(AController* C) override;
+
 	/** Tries to spawn the player's pawn */
 	virtual void RestartPlayer(AController* NewPlayer) override;
 
@@ -46,6 +50,9 @@ class AShooterGameMode : public AGameMode
 	/** returns default pawn class for given controller */
 	virtual UClass* GetDefaultPawnClassForController_Implementation(AController* InController) override;
 
+	/** respawns a pooled dead pawn of the default class if there is one, spawns a new pawn otherwise */
+	virtual APawn* SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform) override;
+
 	/** prevents friendly fire */
 	virtual float ModifyDamage(float Damage, AActor* DamagedActor, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) const;
 
@@ -122,9 +129,19 @@ protected:
 
 	bool bAllowBots;		
 
+	/** seconds the status effect benchmark runs for, 0 when not benchmarking */
+	int32 BenchmarkDuration;
+
+	/** records the status effect benchmark, only spawned in benchmark mode */
+	UPROPERTY(Transient)
+	AShooterBenchmarkDirector* BenchmarkDirector;
+
 	/** spawning all bots for this game */
 	void StartBots();
 
+	/** fill the effect actor pool so freeze and shrink hits don't spawn actors mid match */
+	void PrewarmStatusEffectActors();
+
 	/** initialization for bot after creation */
 	virtual void InitBot(AShooterAIController* AIC, int32 BotNum);
 
@@ -156,6 +173,12 @@ public:
 	/** get the name of the bots count option used in server travel URL */
 	static FString GetBotsCountOptionName();
 
+	/** get the name of the option that runs the status effect benchmark for the given number of seconds */
+	static FString GetBenchmarkOptionName();
+
+	/** is the status effect benchmark running? */
+	bool IsBenchmarkMode() const { return BenchmarkDuration > 0; }
+
 	UPROPERTY()
 	TArray<AShooterPickup*> LevelPickups;
 
@@ -4,6 +4,8 @@
 
 #include "ShooterPlayerState.generated.h"
 
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnShooterPlayerStateStoredWeapon, AShooterPlayerState*, class AShooterWeapon*);
+
 UCLASS()
 class AShooterPlayerState : public APlayerState
 {
@@ -14,6 +16,9 @@ class AShooterPlayerState : public APlayerState
 	/** clear scores */
 	virtual void Reset() override;
 
+	/** destroy stored weapons */
+	virtual void Destroyed() override;
+
 	/**
 	 * Set the team 
 	 *
@@ -86,6 +91,25 @@ class AShooterPlayerState : public APlayerState
 	void SetMatchId(const FString& CurrentMatchId);
 
 	virtual void CopyProperties(class APlayerState* PlayerState) override;
+
+	/**
+	 * [server] keep a weapon that left the inventory of a dead pawn, instead of destroying it.
+	 * The weapon stays hidden with its ammo reset until the next pawn takes it.
+	 */
+	void StoreWeapon(class AShooterWeapon* Weapon);
+
+	/** [server] take a stored weapon of exactly this class, nullptr if there is none. It depends on the player state for replication until equipped. */
+	class AShooterWeapon* TakeStoredWeapon(TSubclassOf<class AShooterWeapon> WeaponClass);
+
+	/** [server] destroy all stored weapons */
+	void DestroyStoredWeapons();
+
+	/** Global notification when a weapon is stored with a player state. Needed for replication graph. */
+	SHOOTERGAME_API static FOnShooterPlayerStateStoredWeapon NotifyStoreWeapon;
+
+	/** Global notification when a weapon that was stored is destroyed before a pawn equips it again. Needed for replication graph. */
+	SHOOTERGAME_API static FOnShooterPlayerStateStoredWeapon NotifyReleaseWeapon;
+
 protected:
 
 	/** Set the mesh colors based on the current teamnum variable */
@@ -119,6 +143,10 @@ protected:
 	UPROPERTY(Replicated)
 	FString MatchId;
 
+	/** weapons of the last life, waiting for the next pawn */
+	UPROPERTY(Transient)
+	TArray<class AShooterWeapon*> StoredWeapons;
+
 	/** helper for scoring points */
 	void ScorePoints(int32 Points);
 };
@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterDroppedWeaponManager.generated.h"
+
+class AShooterPickup_Weapon;
+class AShooterWeapon;
+
+namespace EShooterDropEviction
+{
+	enum Type
+	{
+		Oldest,
+		FarthestFromPlayers,
+	};
+}
+
+//
+// Server side owner of the weapon pickups dropped by dying characters.
+// At most ShooterGame.MaxDroppedWeapons drops exist at once: when the cap is reached the oldest drop,
+// or the one farthest from any living character, is recycled for the new one.
+// Taken pickups are hidden and kept for the next drop, so pickups are not spawned or destroyed once the cap is reached.
+//
+UCLASS()
+class UShooterDroppedWeaponManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	/** [server] show a pickup with the given weapon at Location, reusing an idle or evicted pickup when possible */
+	AShooterPickup_Weapon* DropWeapon(TSubclassOf<AShooterPickup_Weapon> PickupClass, TSubclassOf<AShooterWeapon> WeaponClass, const FVector& Location, int32 Ammo, int32 AmmoInClip);
+
+	/** [server] drop was taken or its life span ran out, hide it and keep it for reuse. Returns false if the pickup isn't an active drop. */
+	bool ReleaseDrop(AShooterPickup_Weapon* Pickup);
+
+	/** number of drops currently in the world */
+	int32 GetNumActiveDrops() const { return ActiveDrops.Num(); }
+
+	/** number of hidden pickups waiting for reuse */
+	int32 GetNumIdlePickups() const { return IdlePickups.Num(); }
+
+	/** print manager state to the log */
+	void DumpStats() const;
+
+private:
+
+	/** pick the drop to recycle when the cap is reached */
+	int32 FindDropToEvict() const;
+
+	/** take an idle pickup of the given class, if any */
+	AShooterPickup_Weapon* TakeIdlePickup(UClass* PickupClass);
+
+	/** drops in the world, oldest first */
+	UPROPERTY()
+	TArray<AShooterPickup_Weapon*> ActiveDrops;
+
+	/** hidden pickups ready for the next drop */
+	UPROPERTY()
+	TArray<AShooterPickup_Weapon*> IdlePickups;
+
+	int32 NumSpawned;
+
+	int32 NumEvicted;
+};
@@ -0,0 +1,115 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterPickupRegistry.generated.h"
+
+class AShooterPickup;
+class AShooterCharacter;
+
+namespace EShooterPickupType
+{
+	enum Type
+	{
+		Ammo,
+		Health,
+		Weapon,
+		MAX,
+	};
+}
+
+/** pickups of one bucket hashed into a uniform 2D grid */
+struct FShooterPickupGrid
+{
+	/** pickups by cell */
+	TMap<FIntPoint, TArray<AShooterPickup*>> Cells;
+
+	/** bounds of all cells ever used, searches don't go past them */
+	FIntPoint MinCell;
+	FIntPoint MaxCell;
+
+	/** number of pickups in the grid */
+	int32 Num;
+
+	FShooterPickupGrid()
+		: MinCell(MAX_int32, MAX_int32)
+		, MaxCell(MIN_int32, MIN_int32)
+		, Num(0)
+	{
+	}
+
+	void Add(AShooterPickup* Pickup, const FIntPoint& Cell);
+
+	void Remove(AShooterPickup* Pickup, const FIntPoint& Cell);
+
+	/** search rings of cells around Location, closest accepted pickup wins if nearer than InOutBestDistSq */
+	AShooterPickup* FindNearest(const FVector& Location, TFunctionRef<bool(AShooterPickup*)> Predicate, float& InOutBestDistSq) const;
+};
+
+//
+// Server side spatial index of pickups, used by bots to find the nearest pickup they can use.
+// Pickups are bucketed by type (ammo per weapon class, health, dropped weapons) and register themselves
+// in BeginPlay / EndPlay. Dropped weapons register again each time they are recycled at a new location.
+//
+UCLASS()
+class UShooterPickupRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** size of a grid cell in world units */
+	static constexpr float CellSize = 2000.0f;
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	/** [server] add pickup at its current location, or move it if it's already registered */
+	void RegisterPickup(AShooterPickup* Pickup);
+
+	/** [server] remove pickup */
+	void UnregisterPickup(AShooterPickup* Pickup);
+
+	/**
+	* [server] find the closest active pickup of the given type that ForPawn can pick up.
+	*
+	* @param Type			Pickup type.
+	* @param WeaponClass	For ammo: weapon the ammo is for, subclasses match as well. Ignored otherwise.
+	* @param Location		Where to search from.
+	* @param ForPawn		Pawn that wants the pickup.
+	*/
+	AShooterPickup* FindNearest(EShooterPickupType::Type Type, UClass* WeaponClass, const FVector& Location, AShooterCharacter* ForPawn) const;
+
+	/** number of registered pickups */
+	int32 GetNumPickups() const { return Registered.Num(); }
+
+	/** get grid cell of a world location */
+	static FIntPoint GetCell(const FVector& Location);
+
+private:
+
+	/** where a pickup was registered */
+	struct FRegisteredPickup
+	{
+		EShooterPickupType::Type Type;
+		UClass* BucketClass;
+		FIntPoint Cell;
+	};
+
+	/** bucket type and class of a pickup */
+	static EShooterPickupType::Type GetPickupType(const AShooterPickup* Pickup, UClass*& OutBucketClass);
+
+	FShooterPickupGrid& GetGrid(EShooterPickupType::Type Type, UClass* BucketClass);
+
+	/** ammo pickups by the weapon class they are for */
+	TMap<UClass*, FShooterPickupGrid> AmmoGrids;
+
+	FShooterPickupGrid HealthGrid;
+
+	FShooterPickupGrid WeaponGrid;
+
+	/** all registered pickups */
+	TMap<AShooterPickup*, FRegisteredPickup> Registered;
+};
@@ -16,7 +16,11 @@ class SHOOTERGAME_API AShooterPickup_Weapon : public AShooterPickup
 	/** check if pawn can use this pickup */
 	virtual bool CanBePickedUp(AShooterCharacter* TestPawn) const override;
 
-	virtual void EndPlay(EEndPlayReason::Type EndReason) override;
+	/** [server] Set the weapon and ammo and show the pickup at Location. Used by UShooterDroppedWeaponManager, also before BeginPlay.*/
+	void ActivateDrop(TSubclassOf<AShooterWeapon> InWeaponClass, int32 InAmmo, int32 InAmmoInClip, const FVector& Location);
+
+	/** [server] Hide the pickup so it can be reused. Stops the life span until the next ActivateDrop.*/
+	void DeactivateDrop();
 
 protected:
 
@@ -35,13 +39,16 @@ protected:
 	/** Indicates whether the pickup was taken or not.*/
 	bool bPickedUp = false;
 
-	/** The spawned weapon actor. */
-	AShooterWeapon* SpawnedWeapon;
+	/** Is there a weapon with ammo to give? */
+	bool HasWeapon() const;
 
-	/** After we recieve the weapon parameters, spawn it into the world.*/
+	/** Called by blueprints after setting the weapon parameters. The weapon is only spawned in GivePickupTo.*/
 	UFUNCTION(BlueprintCallable)
 	void Initialization();
 
-	/** Give pickup. */
+	/** Spawn the weapon with the stored ammo and give it to the pawn. */
 	virtual void GivePickupTo(AShooterCharacter* Pawn) override;
+
+	/** Drops from UShooterDroppedWeaponManager go back to it instead of being destroyed.*/
+	virtual void LifeSpanExpired() override;
 };
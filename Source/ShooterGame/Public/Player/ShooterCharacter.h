@@ -3,6 +3,7 @@
 #pragma once
 
 #include "ShooterTypes.h"
+#include "ShooterEffectActorPool.h"
 #include "ShooterCharacter.generated.h"
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnShooterCharacterEquipWeapon, AShooterCharacter*, AShooterWeapon* /* new */);
@@ -250,6 +251,9 @@ class AShooterCharacter : public ACharacter
 	UFUNCTION(BlueprintCallable, Category = Pawn)
 	bool IsRunning() const;
 
+	/** get the modifier value for movement speed from the replicated pawn scale, same on the server and the owning client */
+	float GetScaleSpeedModifier() const;
+
 	/** get camera view type */
 	UFUNCTION(BlueprintCallable, Category = Mesh)
 	virtual bool IsFirstPerson() const;
@@ -432,6 +436,9 @@ public:
 	// Die when we fall out of the world.
 	virtual void FellOutOfWorld(const class UDamageType& dmgType) override;
 
+	/** [server] make a dead pawn taken from the pawn pool ready to be possessed again */
+	void LeavePawnPool();
+
 	/** Called on the actor right before replication occurs */
 	virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
 protected:
@@ -451,32 +458,64 @@ protected:
 	UFUNCTION()
 	void OnRep_LastTakeHitInfo();
 
+	/** hide the dead pawn once its ragdoll had its time, on every machine. The server hands it to the pawn pool. */
+	void EnterPawnPool();
+
+	/** undo death: meshes, collision, status effects, scale and movement, on every machine */
+	void ResetPooledPawn();
+
+	/** play respawn effects, not on dedicated servers */
+	void PlayRespawnEffects();
+
+	/** [client] pawn was taken from the pawn pool */
+	UFUNCTION()
+	void OnRep_RespawnCount();
+
+	/** dead pawn goes to the pawn pool instead of being torn off and destroyed, set by the server on death */
+	UPROPERTY(Transient, Replicated)
+	uint8 bReturnToPawnPool : 1;
+
+	/** dead pawn is hidden in the pawn pool */
+	uint8 bInPawnPool : 1;
+
+	/** times this pawn was taken from the pawn pool, clients reset the pawn when it changes */
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_RespawnCount)
+	uint8 RespawnCount;
+
+	/** Handle for efficient management of EnterPawnPool timer */
+	FTimerHandle TimerHandle_EnterPawnPool;
+
 	///////////////////////////////////////////////////////////////////////////
 	// New addition.
 	///////////////////////////////////////////////////////////////////////////
 	// General support.
 	
-	/** Spawn an actor from a given class, attach it to the given target and set its lifespan.*/
-	AActor* SpawnAndAttachActor(const TSubclassOf<AActor> ActorClass, AActor* Target, const float LifeSpan) const;
+	/** Take an actor of the given class from the effect actor pool, attach it to the given target and release it after LifeSpan.*/
+	AActor* AcquireAttachedEffectActor(const TSubclassOf<AActor> ActorClass, AActor* Target, const float LifeSpan, FOnPooledEffectReleased OnReleased) const;
+
+	/** Return an effect actor to the pool.*/
+	void ReleaseEffectActor(AActor*& EffectActor) const;
 	
 	virtual void DamageToBot(float DamageTaken, struct FDamageEvent const& DamageEvent, class APawn* PawnInstigator, class AActor* DamageCauser) PURE_VIRTUAL(AShooterCharacter::DamageToBot);
 
-	/** Is there any effect currently on the player? */
-	UPROPERTY()
-	bool bIsAnyEffectActive = false;
+	/** Active freeze / shrink effects, replicated from server. Starting and ending effects is handled in OnStatusEffectChanged.*/
+	UPROPERTY(VisibleDefaultsOnly, Category = StatusEffects)
+	class UShooterStatusEffectComponent* StatusEffects;
 
-	/** Is there any effect currently on the player? Server side variable.*/
-	UPROPERTY()
-	bool bIsAnyEffectActive_Server = false;
+	/** Called on server and clients when an effect starts or ends.*/
+	virtual void OnStatusEffectChanged(EShooterStatusEffect::Type Effect, bool bActive);
 
-	/**
-	* Exaplanation why we need two variables:
-	* Since game can be both on dedicated server and hosted by a player, then we need to track if player has an effect on server side
-	* and on player side (for quick responsivness). In dedicated server there is a copy of the player character on server side, thus,
-	* we don't need two copies of the variable, but on player-hosted server, the host character has only 1 copy of the character.
-	* 
-	* To deal with both cases, we duplicate the variable, and set it on server and on client side.
-	*/
+	/** Get the effect widget cache of the local player controlling this pawn.*/
+	class UShooterEffectOverlayCache* GetEffectOverlayCache() const;
+
+public:
+	/** Get the effect actor classes this character attaches, used to prewarm the effect actor pool.*/
+	void GetStatusEffectActorClasses(TArray<TSubclassOf<AActor>>& OutClasses) const;
+
+	/** Returns StatusEffects subobject **/
+	FORCEINLINE class UShooterStatusEffectComponent* GetStatusEffects() const { return StatusEffects; }
+
+protected:
 
 	///////////////////////////////////////////////////////////////////////////
 	// Freeze support.
@@ -493,21 +532,14 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = Freezing)
 	TSubclassOf<UUserWidget> FreezeWidgetClass;
 
-	/** The spawned freeze actor. We need to destroy it after freeze time passed. */
+	/** The attached freeze actor. Goes back to the pool when the freeze ends. */
 	AActor* FreezeActor;
 
-	/** Handle player freezing, server side.*/
-	void Server_FreezePlayer(AShooterCharacter* DamagedCharacter);
-
 	/** Handle player freezing, local.*/
 	void FreezePlayer();
 
 	/** Handle player unfreezing, local. */
 	void UnfreezePlayer();
-
-	/** Called when freeze actor is destroyed, server side.*/
-	UFUNCTION()
-	void Server_FreezeActorDestroyed(AActor* DestroyedActor);
 	
 	///////////////////////////////////////////////////////////////////////////
 	// Shrink support.
@@ -527,36 +559,72 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = Shrinking)
 	TSubclassOf<AActor> ShrinkActorClass;
 
-	/** The spawned shrink actor. We need to destroy it after shrink time passed. */
+	/** The attached shrink actor. Goes back to the pool when the shrink ends. */
 	AActor* ShrinkActor;
 
 	/** The widget we see when we are shrunk. */
 	UPROPERTY(EditDefaultsOnly, Category = Shrinking)
 	TSubclassOf<UUserWidget> ShrinkWidgetClass;
 	
-	/** Handle player shrinking, server side.*/
-	void Server_ShrinkPlayer(AShooterCharacter* DamagedCharacter);
-	
 	/** Handle player shrinking, local.*/
 	void ShrinkPlayer();
 
 	/** Handle player unshrinking, local.*/
 	void UnshrinkPlayer();
 
-	/** Called when shrink actor is destroyed, server side.*/
-	UFUNCTION()
-	void Server_ShrinkActorDestroyed(AActor* DestroyedActor);
+	/** Pawn scale while shrunk. */
+	UPROPERTY(EditDefaultsOnly, Category = Shrinking, meta = (ClampMin = "0.1", ClampMax = "1.0"))
+	float ShrunkScale = 0.5f;
 
-	UFUNCTION(NetMulticast, Unreliable)
-	void Server_RestorePawnSize(AShooterCharacter* Target);
+	/** Movement speed modifier while fully shrunk, blended with the scale during the transition. */
+	UPROPERTY(EditDefaultsOnly, Category = Shrinking, meta = (ClampMin = "0.0"))
+	float ShrunkSpeedModifier = 0.75f;
 
-	/** Shrink the given player. If Reverse is true, then return to normal scale.*/
+	/** How fast the pawn scale moves towards its target, in scale units per second. */
+	UPROPERTY(EditDefaultsOnly, Category = Shrinking)
+	float ScaleInterpSpeed = 2.0f;
+
+	/** Target pawn scale in percent, set by the server. Every machine interpolates towards it locally. */
+	UPROPERTY(Transient, Replicated)
+	uint8 TargetScalePercent = 100;
+
+	/** Pawn scale in percent when the target last changed. */
+	UPROPERTY(Transient, Replicated)
+	uint8 StartScalePercent = 100;
+
+	/** Server world time when the target last changed. */
+	UPROPERTY(Transient, Replicated)
+	float ScaleChangeTime = 0.0f;
+
+	/** Current local pawn scale, applied to the capsule which carries meshes and camera. */
+	float CurrentScale = 1.0f;
+
+	/** [server] set the scale the pawn should move to. */
+	void SetTargetScale(float NewScale);
+
+	/** Get the target scale from the replicated value. */
+	FORCEINLINE float GetTargetScale() const { return TargetScalePercent / 100.0f; }
+
+	/** Scale the pawn has at the current server time, from replicated values only, so movement speed doesn't depend on local interpolation. */
+	float GetReplicatedScale() const;
+
+	/** Move the current scale towards the target. */
+	void UpdatePawnScale(float DeltaSeconds);
+
+	/** Apply scale to the pawn, keeping the bottom of the capsule where it is. */
+	void ApplyPawnScale(float NewScale);
+
+	/** Shrink the given player. If Reverse is true, then return to normal scale. Implemented by the pawn blueprints, the scale itself is set natively.*/
 	UFUNCTION(BlueprintImplementableEvent, BlueprintAuthorityOnly, Category = Shrinking)
 	void Server_ShrinkEvent(AShooterCharacter* Target, bool bReverse);
 
 	//////////////////////////////////////////////////////////////////////////
 	// Weapon dropping.
 
+	/** Pickup dropped with the held weapon on death, recycled by UShooterDroppedWeaponManager. If not set, Server_CharacterDied is called instead.*/
+	UPROPERTY(EditDefaultsOnly, Category = Death)
+	TSubclassOf<class AShooterPickup_Weapon> DroppedWeaponPickupClass;
+
 	/** When character dies (player or bot), call this event with the weapon the character has, the current ammo and the ammo in the clip.*/
 	UFUNCTION(BlueprintImplementableEvent, BlueprintAuthorityOnly, Category = Death)
 	void Server_CharacterDied(TSubclassOf<AShooterWeapon> HeldWeapon, FVector DeathLocation, int32 CurrentAmmo, int32 CurrentAmmoInClip);
@@ -579,10 +647,10 @@ public:
 	UFUNCTION()
 	void OnRep_CurrentWeapon(class AShooterWeapon* LastWeapon);
 
-	/** [server] spawns default inventory */
+	/** [server] spawns default inventory, reusing the weapons stored with the player state */
 	void SpawnDefaultInventory();
 
-	/** [server] remove all weapons from inventory and destroy them */
+	/** [server] remove all weapons from inventory and store them with the player state, or destroy them if there is none */
 	void DestroyInventory();
 
 	/** equip weapon */
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterLagCompensation.generated.h"
+
+class AShooterCharacter;
+
+/**
+ * Recent hitbox poses of one pawn, oldest overwritten first.
+ * Fields are split so the time search only touches the Times array.
+ */
+struct FShooterHitboxHistory
+{
+	/** samples kept per pawn, about one second at 60Hz */
+	static const int32 NumSamples = 64;
+
+	/** server time of each sample */
+	float Times[NumSamples];
+
+	/** hitbox center of each sample */
+	FVector Centers[NumSamples];
+
+	/** hitbox half size of each sample */
+	FVector Extents[NumSamples];
+
+	/** index of the newest sample */
+	int32 Head;
+
+	/** number of valid samples */
+	int32 Num;
+
+	FShooterHitboxHistory()
+		: Head(NumSamples - 1)
+		, Num(0)
+	{
+	}
+
+	/** store a new sample, must be newer than the last one */
+	void Add(float Time, const FVector& Center, const FVector& Extent);
+
+	/** hitbox interpolated at Time, clamped to the oldest / newest sample */
+	bool GetAtTime(float Time, FVector& OutCenter, FVector& OutExtent) const;
+
+	/** physical index of the sample Age steps older than the newest */
+	FORCEINLINE int32 GetIndex(int32 Age) const
+	{
+		return (Head - Age) & (NumSamples - 1);
+	}
+};
+
+//
+// Server side hitbox history of all living pawns, sampled once per frame after movement.
+// Client reported hits are checked against the pose the target had when the client fired,
+// which costs one binary search over a single pawn's samples per shot, however many pawns exist.
+//
+UCLASS()
+class UShooterLagCompensation : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/** [server] start recording pawn */
+	void RegisterPawn(AShooterCharacter* Pawn);
+
+	/** [server] stop recording pawn */
+	void UnregisterPawn(AShooterCharacter* Pawn);
+
+	/**
+	* [server] get the hitbox pawn had at the given server time.
+	*
+	* @param Pawn		Pawn to rewind.
+	* @param Time		Server time, clamped to the last ShooterGame.MaxLagCompensation seconds.
+	* @returns false if pawn isn't recorded
+	*/
+	bool GetHitboxAtTime(const AShooterCharacter* Pawn, float Time, FVector& OutCenter, FVector& OutExtent) const;
+
+	/** server time the client saw when firing, sent along with hits */
+	static float GetClientFireTime(const UWorld* World);
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+private:
+
+	/** recorded pawns, same index as Histories */
+	TArray<TWeakObjectPtr<AShooterCharacter>> Pawns;
+
+	/** history of each recorded pawn */
+	TArray<FShooterHitboxHistory> Histories;
+
+	/** index of each recorded pawn */
+	TMap<const AShooterCharacter*, int32> PawnIndices;
+
+	/** remove pawn at index, keeps arrays packed */
+	void RemoveAt(int32 Index);
+};
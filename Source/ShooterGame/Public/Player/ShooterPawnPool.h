@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterPawnPool.generated.h"
+
+class AShooterCharacter;
+
+USTRUCT()
+struct FShooterPooledPawns
+{
+	GENERATED_BODY()
+
+	/** dead pawns ready to be respawned */
+	UPROPERTY()
+	TArray<AShooterCharacter*> Pawns;
+};
+
+//
+// Server side pool of dead player and bot pawns, one list per class.
+// Dying pawns aren't torn off when pooling is on. Once their ragdoll had its time they are hidden and handed here,
+// and the next RestartPlayer for the same pawn class teleports and resets one instead of spawning a new actor.
+//
+UCLASS()
+class UShooterPawnPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	/** is ShooterGame.PawnPooling on? */
+	static bool IsPoolingEnabled();
+
+	/** how long dead pooled pawns ragdoll before they go back to the pool */
+	static float GetRagdollTime();
+
+	/** [server] take a pawn of exactly this class from the pool and respawn it at the transform, nullptr if there is none */
+	AShooterCharacter* AcquirePawn(UClass* PawnClass, const FTransform& SpawnTransform);
+
+	/** [server] return a dead pawn to the pool, it's destroyed if the pool is full */
+	void ReleasePawn(AShooterCharacter* Pawn);
+
+	/** number of respawns served by a pooled pawn */
+	int32 GetNumHits() const { return NumHits; }
+
+	/** number of respawns that had to spawn a new pawn */
+	int32 GetNumMisses() const { return NumMisses; }
+
+	/** count a respawn that spawned a new pawn */
+	void NotifyPawnSpawned();
+
+	/** print pool state to the log */
+	void DumpStats() const;
+
+private:
+
+	/** idle pawns per class */
+	UPROPERTY()
+	TMap<UClass*, FShooterPooledPawns> FreePawns;
+
+	/** idle pawns in all lists */
+	int32 NumPooled;
+
+	int32 NumHits;
+
+	int32 NumMisses;
+};
@@ -4,6 +4,7 @@
 
 #include "Online.h"
 #include "ShooterLeaderboards.h"
+#include "Weapons/ShooterWeaponStats.h"
 #include "ShooterPlayerController.generated.h"
 
 class AShooterHUD;
@@ -37,6 +38,10 @@ public:
 	UFUNCTION(reliable, client)
 	void ClientSendRoundEndEvent(bool bIsWinner, int32 ExpendedTimeInSeconds);
 
+	/** weapon stats reloaded on the server, see ShooterGame.ReloadWeaponStats */
+	UFUNCTION(reliable, client)
+	void ClientReceiveWeaponStats(const TArray<FName>& RowNames, const TArray<FShooterWeaponStatsRow>& Rows);
+
 	/** used for input simulation from blueprint (for automatic perf tests) */
 	UFUNCTION(BlueprintCallable, Category="Input")
 	void SimulateInputKey(FKey Key, bool bPressed = true);
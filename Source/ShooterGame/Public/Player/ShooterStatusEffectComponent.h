@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "ShooterTypes.h"
+#include "ShooterTimingWheel.h"
+#include "Components/ActorComponent.h"
+#include "ShooterStatusEffectComponent.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnShooterStatusEffectChanged, EShooterStatusEffect::Type /* Effect */, bool /* bActive */);
+
+/** replicated status effect state: active bit per effect and when it ends in quantized server time */
+USTRUCT()
+struct FShooterStatusEffectState
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** quantized time steps per second, expiry times wrap around every 65536 steps */
+	static const int32 TimeStepsPerSecond = 10;
+
+	/** one bit per EShooterStatusEffect::Type */
+	uint8 ActiveMask;
+
+	/** server time when each active effect ends, in quantized steps */
+	uint16 ExpiryTime[EShooterStatusEffect::MAX];
+
+	FShooterStatusEffectState()
+		: ActiveMask(0)
+	{
+		FMemory::Memzero(ExpiryTime);
+	}
+
+	FORCEINLINE bool IsActive(EShooterStatusEffect::Type Effect) const
+	{
+		return (ActiveMask & (1 << Effect)) != 0;
+	}
+
+	/** quantize time in seconds, rounded up so effects never end early */
+	static uint16 QuantizeTime(float TimeSeconds)
+	{
+		return (uint16)(FMath::CeilToInt(TimeSeconds * TimeStepsPerSecond) & 0xFFFF);
+	}
+
+	/** seconds from Now until quantized time, negative once it has passed */
+	static float GetTimeUntil(uint16 QuantizedTime, float Now)
+	{
+		const int16 Delta = (int16)(QuantizedTime - (uint16)(FMath::FloorToInt(Now * TimeStepsPerSecond) & 0xFFFF));
+		return (float)Delta / TimeStepsPerSecond;
+	}
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FShooterStatusEffectState& Other) const;
+};
+
+template<>
+struct TStructOpsTypeTraits<FShooterStatusEffectState> : public TStructOpsTypeTraitsBase2<FShooterStatusEffectState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+//
+// Timed status effects (freeze, shrink) of a character.
+// The server owns the state and registers expiries with UShooterStatusEffectScheduler,
+// clients get it through replication and react in OnEffectChanged.
+// Only one effect can be active at a time.
+//
+UCLASS()
+class UShooterStatusEffectComponent : public UActorComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/** [server] start effect for Duration seconds, fails while any effect is active */
+	bool ApplyEffect(EShooterStatusEffect::Type Effect, float Duration);
+
+	/** [server] end effect now */
+	void RemoveEffect(EShooterStatusEffect::Type Effect);
+
+	/** end all effects now, also used locally by dying pawns that no longer receive replication */
+	void RemoveAllEffects();
+
+	/** is effect active? */
+	FORCEINLINE bool HasEffect(EShooterStatusEffect::Type Effect) const { return State.IsActive(Effect); }
+
+	/** is there any effect active? */
+	FORCEINLINE bool IsAnyEffectActive() const { return State.ActiveMask != 0; }
+
+	/** seconds left on the effect, 0 if not active */
+	float GetRemainingTime(EShooterStatusEffect::Type Effect) const;
+
+	/** called on server and clients when an effect starts or ends */
+	FOnShooterStatusEffectChanged OnEffectChanged;
+
+	/** [server] called by the scheduler when effect time is up */
+	void OnEffectExpired(EShooterStatusEffect::Type Effect);
+
+	/** [server] drop pending expiries */
+	virtual void OnUnregister() override;
+
+protected:
+
+	/** current effects */
+	UPROPERTY(ReplicatedUsing=OnRep_State)
+	FShooterStatusEffectState State;
+
+	/** effects we already broadcasted as active */
+	uint8 NotifiedMask;
+
+	/** [server] pending expiry of each active effect */
+	FShooterTimingWheelHandle ExpiryHandles[EShooterStatusEffect::MAX];
+
+	/** [server] cancel pending expiries of effects not in mask */
+	void CancelExpiries(uint8 KeepMask);
+
+	/** broadcast effects that started / ended since last notify */
+	UFUNCTION()
+	void OnRep_State();
+
+	/** server time shared by server and clients */
+	float GetServerTime() const;
+
+	/** set new mask and notify about changes */
+	void SetActiveMask(uint8 NewMask);
+};
@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "ShooterTypes.h"
+#include "ShooterTimingWheel.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterStatusEffectScheduler.generated.h"
+
+class UShooterStatusEffectComponent;
+
+/** what to end when a scheduled expiry fires */
+struct FShooterStatusEffectExpiry
+{
+	TWeakObjectPtr<UShooterStatusEffectComponent> Component;
+	EShooterStatusEffect::Type Effect;
+
+	FShooterStatusEffectExpiry()
+		: Effect(EShooterStatusEffect::MAX)
+	{
+	}
+};
+
+//
+// Server side owner of all status effect expirations.
+// Expiries live in a timing wheel stepping at the replicated expiry resolution, so insert and cancel are O(1)
+// and everything due is ended in one batch per frame, whatever the number of active effects.
+//
+UCLASS()
+class UShooterStatusEffectScheduler : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/** [server] end Effect on Component at server time ExpireTime */
+	FShooterTimingWheelHandle ScheduleExpiry(UShooterStatusEffectComponent* Component, EShooterStatusEffect::Type Effect, float ExpireTime);
+
+	/** [server] drop a pending expiry */
+	void CancelExpiry(FShooterTimingWheelHandle& Handle);
+
+	/** number of pending expiries */
+	int32 GetNumPending() const { return Wheel.Num(); }
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+private:
+
+	/** wheel step for a server time */
+	static uint64 GetStepForTime(float TimeSeconds);
+
+	/** pending expiries */
+	TShooterTimingWheel<FShooterStatusEffectExpiry> Wheel;
+
+	/** expiries fired this frame, kept to avoid reallocating */
+	TArray<FShooterStatusEffectExpiry> ExpiredThisFrame;
+};
@@ -0,0 +1,249 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** handle to a scheduled timing wheel entry, stays safe to use after the entry fired or was cancelled */
+struct FShooterTimingWheelHandle
+{
+	int32 Index;
+	uint32 Generation;
+
+	FShooterTimingWheelHandle()
+		: Index(INDEX_NONE)
+		, Generation(0)
+	{
+	}
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+
+	void Invalidate() { Index = INDEX_NONE; }
+};
+
+/**
+ * Hierarchical timing wheel: NumLevels wheels of 64 slots, each slot covering 64 times the range of the level below.
+ * Time is measured in integer steps. Insert and cancel are O(1), entries move down one level at most once per level
+ * on their way to expiring, and advancing fires everything due in the same pass.
+ */
+template<typename PayloadType, int32 NumLevels = 4>
+class TShooterTimingWheel
+{
+public:
+
+	TShooterTimingWheel()
+		: CurrentStep(0)
+		, FreeListHead(INDEX_NONE)
+		, NumScheduled(0)
+	{
+		for (int32 SlotIdx = 0; SlotIdx < NumLevels * SlotsPerLevel; SlotIdx++)
+		{
+			SlotHeads[SlotIdx] = INDEX_NONE;
+		}
+	}
+
+	/** start counting from Step, only valid while nothing is scheduled */
+	void Reset(uint64 Step)
+	{
+		check(NumScheduled == 0);
+		CurrentStep = Step;
+	}
+
+	/** last step the wheel advanced to */
+	uint64 GetCurrentStep() const { return CurrentStep; }
+
+	/** number of pending entries */
+	int32 Num() const { return NumScheduled; }
+
+	/** schedule payload to fire at ExpireStep, steps that already passed fire on the next advance */
+	FShooterTimingWheelHandle Schedule(uint64 ExpireStep, const PayloadType& Payload)
+	{
+		int32 EntryIdx = FreeListHead;
+		if (EntryIdx != INDEX_NONE)
+		{
+			FreeListHead = Entries[EntryIdx].Next;
+		}
+		else
+		{
+			EntryIdx = Entries.AddDefaulted();
+		}
+
+		FEntry& Entry = Entries[EntryIdx];
+		Entry.ExpireStep = FMath::Max(ExpireStep, CurrentStep + 1);
+		Entry.Payload = Payload;
+		LinkEntry(EntryIdx);
+		NumScheduled++;
+
+		FShooterTimingWheelHandle Handle;
+		Handle.Index = EntryIdx;
+		Handle.Generation = Entry.Generation;
+		return Handle;
+	}
+
+	/** remove a pending entry, returns false if it already fired or was cancelled */
+	bool Cancel(FShooterTimingWheelHandle& Handle)
+	{
+		const bool bPending = IsPending(Handle);
+		if (bPending)
+		{
+			UnlinkEntry(Handle.Index);
+			FreeEntry(Handle.Index);
+		}
+		Handle.Invalidate();
+		return bPending;
+	}
+
+	/** is the entry still waiting to fire? */
+	bool IsPending(const FShooterTimingWheelHandle& Handle) const
+	{
+		return Entries.IsValidIndex(Handle.Index) && Entries[Handle.Index].Slot != INDEX_NONE && Entries[Handle.Index].Generation == Handle.Generation;
+	}
+
+	/** advance to TargetStep, appending payloads of everything that expired on the way */
+	void Advance(uint64 TargetStep, TArray<PayloadType>& OutExpired)
+	{
+		while (CurrentStep < TargetStep)
+		{
+			CurrentStep++;
+
+			// entries of higher levels move down once the level below wrapped around
+			for (int32 Level = NumLevels - 1; Level > 0; Level--)
+			{
+				if ((CurrentStep & ((1ull << (Level * BitsPerLevel)) - 1)) == 0)
+				{
+					Cascade(Level);
+				}
+			}
+
+			const int32 SlotIdx = (int32)(CurrentStep & SlotMask);
+			int32 EntryIdx = SlotHeads[SlotIdx];
+			SlotHeads[SlotIdx] = INDEX_NONE;
+			while (EntryIdx != INDEX_NONE)
+			{
+				const int32 NextIdx = Entries[EntryIdx].Next;
+				OutExpired.Add(Entries[EntryIdx].Payload);
+				FreeEntry(EntryIdx);
+				EntryIdx = NextIdx;
+			}
+
+			// nothing left to find, jump straight to the target
+			if (NumScheduled == 0)
+			{
+				CurrentStep = TargetStep;
+			}
+		}
+	}
+
+private:
+
+	enum
+	{
+		BitsPerLevel = 6,
+		SlotsPerLevel = 1 << BitsPerLevel,
+		SlotMask = SlotsPerLevel - 1,
+	};
+
+	struct FEntry
+	{
+		uint64 ExpireStep;
+		PayloadType Payload;
+		int32 Prev;
+		int32 Next;
+		/** slot the entry is linked in, INDEX_NONE when free */
+		int32 Slot;
+		uint32 Generation;
+
+		FEntry()
+			: ExpireStep(0)
+			, Prev(INDEX_NONE)
+			, Next(INDEX_NONE)
+			, Slot(INDEX_NONE)
+			, Generation(0)
+		{
+		}
+	};
+
+	/** pick the slot for an entry based on how far away it expires */
+	int32 GetSlotFor(uint64 ExpireStep) const
+	{
+		const uint64 Delta = ExpireStep - CurrentStep;
+		for (int32 Level = 0; Level < NumLevels - 1; Level++)
+		{
+			if (Delta < (1ull << ((Level + 1) * BitsPerLevel)))
+			{
+				return Level * SlotsPerLevel + (int32)((ExpireStep >> (Level * BitsPerLevel)) & SlotMask);
+			}
+		}
+
+		// clamp anything beyond the range of the wheel to the top level
+		const uint64 MaxStep = CurrentStep + (1ull << (NumLevels * BitsPerLevel)) - 1;
+		const uint64 ClampedStep = FMath::Min(ExpireStep, MaxStep);
+		return (NumLevels - 1) * SlotsPerLevel + (int32)((ClampedStep >> ((NumLevels - 1) * BitsPerLevel)) & SlotMask);
+	}
+
+	void LinkEntry(int32 EntryIdx)
+	{
+		FEntry& Entry = Entries[EntryIdx];
+		Entry.Slot = GetSlotFor(Entry.ExpireStep);
+		Entry.Prev = INDEX_NONE;
+		Entry.Next = SlotHeads[Entry.Slot];
+		if (Entry.Next != INDEX_NONE)
+		{
+			Entries[Entry.Next].Prev = EntryIdx;
+		}
+		SlotHeads[Entry.Slot] = EntryIdx;
+	}
+
+	void UnlinkEntry(int32 EntryIdx)
+	{
+		FEntry& Entry = Entries[EntryIdx];
+		if (Entry.Prev != INDEX_NONE)
+		{
+			Entries[Entry.Prev].Next = Entry.Next;
+		}
+		else
+		{
+			SlotHeads[Entry.Slot] = Entry.Next;
+		}
+		if (Entry.Next != INDEX_NONE)
+		{
+			Entries[Entry.Next].Prev = Entry.Prev;
+		}
+	}
+
+	void FreeEntry(int32 EntryIdx)
+	{
+		FEntry& Entry = Entries[EntryIdx];
+		Entry.Slot = INDEX_NONE;
+		Entry.Generation++;
+		Entry.Payload = PayloadType();
+		Entry.Prev = INDEX_NONE;
+		Entry.Next = FreeListHead;
+		FreeListHead = EntryIdx;
+		NumScheduled--;
+	}
+
+	/** move all entries of the current slot in Level to lower levels */
+	void Cascade(int32 Level)
+	{
+		const int32 SlotIdx = Level * SlotsPerLevel + (int32)((CurrentStep >> (Level * BitsPerLevel)) & SlotMask);
+		int32 EntryIdx = SlotHeads[SlotIdx];
+		SlotHeads[SlotIdx] = INDEX_NONE;
+		while (EntryIdx != INDEX_NONE)
+		{
+			const int32 NextIdx = Entries[EntryIdx].Next;
+			LinkEntry(EntryIdx);
+			EntryIdx = NextIdx;
+		}
+	}
+
+	/** entry storage, freed entries are chained through Next */
+	TArray<FEntry> Entries;
+
+	/** first entry of each slot, level by level */
+	int32 SlotHeads[NumLevels * SlotsPerLevel];
+
+	uint64 CurrentStep;
+
+	int32 FreeListHead;
+
+	int32 NumScheduled;
+};
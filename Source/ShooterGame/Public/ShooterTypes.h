@@ -59,6 +59,17 @@ namespace EShooterPhysMaterialType
 	};
 }
 
+/** timed effects a character can be under, one bit each in the replicated status effect mask */
+namespace EShooterStatusEffect
+{
+	enum Type
+	{
+		Freeze,
+		Shrink,
+		MAX,
+	};
+}
+
 namespace EShooterDialogType
 {
 	enum Type
@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "GauntletTestController.h"
+#include "ShooterTestControllerBotFreezeBenchmark.generated.h"
+
+class AShooterAIController;
+
+/**
+ * Freezes the bots in a running match with the old unpossess / possess approach and with the suspended brain,
+ * and logs the cost per bot of both. Each approach runs on its own half of the bots. Right after the last unfreeze,
+ * before the behavior trees tick again, every blackboard key is compared with its value from before the freeze,
+ * so the log shows which approach keeps the bots' state.
+ * Run on a map with bots, e.g. "Highrise?Bots=32 -gauntlet=ShooterTestControllerBotFreezeBenchmark".
+ * Optional: -BenchmarkBots=N (bots to wait for), -BenchmarkIterations=N (freeze / unfreeze cycles per approach).
+ */
+UCLASS()
+class UShooterTestControllerBotFreezeBenchmark : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void OnInit() override;
+	virtual void OnTick(float TimeDelta) override;
+
+	/** blackboard state of the bots that took part in a pass */
+	struct FPassResult
+	{
+		/** average microseconds per bot and freeze / unfreeze cycle */
+		double Time = 0.0;
+		int32 NumBots = 0;
+		/** bots with at least one key that changed during the pass */
+		int32 NumBotsChanged = 0;
+		/** blackboard keys of all bots, and how many of them were cleared or changed by the freeze */
+		int32 NumKeys = 0;
+		int32 NumKeysChanged = 0;
+	};
+
+	/** freeze and unfreeze the bots, then compare their blackboards with the values from before */
+	FPassResult RunPass(const TArray<AShooterAIController*>& Bots, bool bSuspend) const;
+
+	/** values of all blackboard keys, as the blackboard describes them */
+	static void SnapshotBlackboard(AShooterAIController* Bot, TArray<FString>& OutValues);
+
+	/** bots currently possessing a living pawn */
+	void GatherBots(TArray<AShooterAIController*>& OutBots) const;
+
+	int32 NumBots;
+	int32 NumIterations;
+	double WaitStartTime;
+
+	/** give up waiting for all bots after this long */
+	const double MaxWaitTime = 120.0;
+};
@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "GauntletTestController.h"
+#include "ShooterTestControllerLastShotTest.generated.h"
+
+/**
+ * Client test: fires one shot with the equipped instant hit weapon and releases the trigger in the same frame.
+ * The shot has to be sent to the server before ServerStopFire, otherwise the idle server weapon drops the hit.
+ * Run on a client connected to a server, e.g. "127.0.0.1 -gauntlet=ShooterTestControllerLastShotTest".
+ */
+UCLASS()
+class UShooterTestControllerLastShotTest : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void OnInit() override;
+	virtual void OnTick(float TimeDelta) override;
+
+	double WaitStartTime;
+
+	/** give up waiting for a pawn with a loaded instant hit weapon after this long */
+	const double MaxWaitTime = 120.0;
+};
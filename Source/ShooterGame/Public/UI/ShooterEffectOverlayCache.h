@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "Components/SlateWrapperTypes.h"
+#include "ShooterEffectOverlayCache.generated.h"
+
+class UUserWidget;
+class UWidgetAnimation;
+
+/** cached overlay widget and the animations to restart when it's shown again */
+USTRUCT()
+struct FShooterEffectOverlay
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	UUserWidget* Widget;
+
+	UPROPERTY()
+	TArray<UWidgetAnimation*> Animations;
+
+	/** visibility set up in the widget blueprint, restored when shown */
+	ESlateVisibility ShownVisibility;
+
+	FShooterEffectOverlay()
+		: Widget(nullptr)
+		, ShownVisibility(ESlateVisibility::SelfHitTestInvisible)
+	{
+	}
+};
+
+//
+// Full screen status effect overlays (freeze, shrink) of a local player.
+// Each widget class is created once per player and then shown / hidden, so taking hits doesn't add widgets to the viewport.
+//
+UCLASS()
+class UShooterEffectOverlayCache : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/** show overlay of the given class, creating it the first time, and restart its animations */
+	UUserWidget* ShowOverlay(TSubclassOf<UUserWidget> WidgetClass);
+
+	/** hide overlay of the given class if it exists */
+	void HideOverlay(TSubclassOf<UUserWidget> WidgetClass);
+
+	/** number of overlay widgets alive for this player */
+	int32 GetNumLiveWidgets() const { return Overlays.Num(); }
+
+private:
+
+	/** drop widgets that belong to a world going away */
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	/** remove all widgets from the cache */
+	void ClearOverlays();
+
+	/** overlays by widget class */
+	UPROPERTY()
+	TMap<UClass*, FShooterEffectOverlay> Overlays;
+
+	FDelegateHandle OnWorldCleanupHandle;
+};
@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterExplosionResolver.generated.h"
+
+/** explosion waiting for the end of frame */
+struct FShooterQueuedExplosion
+{
+	FVector Origin;
+	float BaseDamage;
+	float Radius;
+	TSubclassOf<UDamageType> DamageType;
+	TWeakObjectPtr<AActor> DamageCauser;
+	TWeakObjectPtr<AController> InstigatedBy;
+};
+
+/** pawn in the explosion grid, with the occlusion traces already done against it this frame */
+struct FShooterExplosionTarget
+{
+	APawn* Pawn;
+
+	/** capsule of the pawn, or its bounds as a capsule */
+	FVector Center;
+	float HalfHeight;
+	float Radius;
+
+	/** trace starts that did / didn't reach the pawn */
+	TArray<FVector, TInlineAllocator<4>> VisibleFrom;
+	TArray<FVector, TInlineAllocator<4>> BlockedFrom;
+};
+
+//
+// Server side radial damage of every explosion in a frame, resolved together at the end of the frame.
+// Pawns are put in a uniform grid once, each explosion only looks at the cells it covers,
+// and an occlusion trace to a pawn is reused by explosions that went off close to the first one.
+// Damage still goes through TakeDamage with a FRadialDamageEvent, so falloff and ModifyDamage work as with ApplyRadialDamage.
+//
+UCLASS()
+class UShooterExplosionResolver : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/** is ShooterGame.BatchRadialDamage on? */
+	static bool IsBatchingEnabled();
+
+	/** [server] apply radial damage with linear falloff at the end of the frame */
+	void QueueExplosion(const FVector& Origin, float BaseDamage, float Radius, TSubclassOf<UDamageType> DamageType, AActor* DamageCauser, AController* InstigatedBy);
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/** grid cell size */
+	static const float CellSize;
+
+	/** explosions closer than this share occlusion traces */
+	static const float OcclusionShareDistance;
+
+private:
+
+	/** put all pawns that can be damaged in the grid */
+	void BuildGrid();
+
+	/** damage all pawns in reach of the explosion */
+	void ResolveExplosion(const FShooterQueuedExplosion& Explosion);
+
+	/** can the explosion see the pawn? traces at most once per nearby origin */
+	bool IsVisibleFrom(FShooterExplosionTarget& Target, const FVector& Origin, AActor* DamageCauser);
+
+	/** grid cell of a location */
+	static FIntPoint GetCell(const FVector& Location);
+
+	/** explosions of this frame */
+	TArray<FShooterQueuedExplosion> PendingExplosions;
+
+	/** pawns of this frame */
+	TArray<FShooterExplosionTarget> Targets;
+
+	/** target indices per cell */
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> Cells;
+
+	/** largest pawn radius in the grid, cells are searched this much beyond the explosion radius */
+	float MaxTargetExtent;
+};
@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterHitRejectionTelemetry.generated.h"
+
+/** why the server didn't accept a client reported hit */
+enum class EShooterHitRejection : uint8
+{
+	/** hit direction too far from the view direction */
+	ViewAngle,
+	/** outside the target's rewound hitbox */
+	RewoundHitbox,
+	/** outside the target's inflated bounding box */
+	Bounds,
+	/** anything else */
+	Other,
+	Max,
+};
+
+/**
+ * Hit rejections of one connection since the last summary.
+ * Errors go in fixed buckets, so recording a rejection is a few increments.
+ */
+struct FShooterHitRejectionStats
+{
+	/** buckets per histogram */
+	static const int32 NumBuckets = 8;
+
+	/** upper bound of each distance error bucket (cm), the last one takes the rest */
+	static const float DistanceBuckets[NumBuckets - 1];
+
+	/** upper bound of each angle error bucket (degrees), the last one takes the rest */
+	static const float AngleBuckets[NumBuckets - 1];
+
+	/** rejections by reason */
+	uint32 Rejections[(int32)EShooterHitRejection::Max];
+
+	/** how far hits landed outside the accepted box */
+	uint32 DistanceErrors[NumBuckets];
+
+	/** how far hits were outside the accepted view cone */
+	uint32 AngleErrors[NumBuckets];
+
+	/** total of Rejections */
+	uint32 Total;
+
+	FShooterHitRejectionStats()
+	{
+		Reset();
+	}
+
+	/** count a rejection, negative errors aren't recorded */
+	void Add(EShooterHitRejection Reason, float DistanceError, float AngleError);
+
+	void Reset();
+
+	/** bucket of Value in a histogram with the given bounds */
+	static int32 GetBucket(const float* Bounds, float Value);
+};
+
+//
+// Server side telemetry of rejected client hits, per connection.
+// Weapons only bump counters when rejecting a hit. Every ShooterGame.HitRejectionSummaryInterval seconds
+// one log line per offending connection is written, and the counters are appended to a csv in the profiling directory,
+// so a flood of bad hits from one client costs neither string formatting nor file writes per shot.
+//
+UCLASS()
+class UShooterHitRejectionTelemetry : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	/**
+	* [server] record a rejected hit.
+	*
+	* @param PC				Controller of the connection the hit came from.
+	* @param Reason			Check that failed.
+	* @param DistanceError	Distance outside the accepted box, negative if not applicable.
+	* @param AngleError		Degrees outside the accepted view cone, negative if not applicable.
+	*/
+	void RecordRejection(APlayerController* PC, EShooterHitRejection Reason, float DistanceError, float AngleError);
+
+	/** log and export the counters now */
+	void Flush();
+
+	/** print counters since the last summary to the log */
+	void DumpStats() const;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+private:
+
+	/** append one row per connection to the csv */
+	void WriteCSV(float Time, const TArray<TPair<FString, FShooterHitRejectionStats>>& Rows);
+
+	/** label of a connection in the log and csv */
+	static FString GetConnectionName(const APlayerController* PC);
+
+	/** counters by connection */
+	TMap<TWeakObjectPtr<APlayerController>, FShooterHitRejectionStats> Connections;
+
+	/** time of the next summary, 0 if nothing was recorded since the last one */
+	float NextSummaryTime;
+
+	/** csv of this session, created on first write */
+	FString CSVFilename;
+};
@@ -9,6 +9,32 @@
 class UProjectileMovementComponent;
 class USphereComponent;
 
+/** replicated flight state of a pooled projectile */
+USTRUCT()
+struct FShooterProjectileState
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** bumped on every launch, so clients can tell a reused projectile from the previous flight */
+	UPROPERTY()
+	uint8 LaunchId;
+
+	/** is it flying (or showing its explosion), false while parked in the pool */
+	UPROPERTY()
+	bool bActive;
+
+	/** did it explode? */
+	UPROPERTY()
+	bool bExploded;
+
+	FShooterProjectileState()
+		: LaunchId(0)
+		, bActive(false)
+		, bExploded(false)
+	{
+	}
+};
+
 // 
 UCLASS(Abstract, Blueprintable)
 class AShooterProjectile : public AActor
@@ -18,9 +44,21 @@ class AShooterProjectile : public AActor
 	/** initial setup */
 	virtual void PostInitializeComponents() override;
 
+	/** leave the projectile mover */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** step movement, called by the projectile mover instead of a component tick */
+	void TickMovement(float DeltaTime);
+
 	/** setup velocity */
 	void InitVelocity(FVector& ShootDirection);
 
+	/** [server] fly from origin, reusing this projectile if it was parked */
+	void LaunchProjectile(const FVector& Origin, const FVector& ShootDirection);
+
+	/** [server] is it parked in its weapon's pool? */
+	bool IsParked() const { return !State.bActive; }
+
 	/** handle hit */
 	UFUNCTION()
 	void OnImpact(const FHitResult& HitResult);
@@ -48,20 +86,35 @@ protected:
 	/** projectile data */
 	struct FProjectileWeaponData WeaponConfig;
 
-	/** did it explode? */
-	UPROPERTY(Transient, ReplicatedUsing=OnRep_Exploded)
-	bool bExploded;
+	/** launch / explosion / parking, replicated in one property so clients see them in order */
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_State)
+	FShooterProjectileState State;
 
-	/** [client] explosion happened */
+	/** [client] launched, exploded or parked */
 	UFUNCTION()
-	void OnRep_Exploded();
+	void OnRep_State(const FShooterProjectileState& PreviousState);
+
+	/** [client] explosion happened */
+	void SimulateExplosion();
 
 	/** trigger explosion */
 	void Explode(const FHitResult& Impact);
 
-	/** shutdown projectile and prepare for destruction */
+	/** shutdown projectile and prepare for parking */
 	void DisableAndDestroy();
 
+	/** [server] flight is over, return to the weapon's pool or destroy if it's gone */
+	void ParkProjectile();
+
+	/** reset components for a new flight */
+	void ActivateProjectile();
+
+	/** hide and stop components while parked */
+	void DeactivateProjectile();
+
+	/** Handle for efficient management of ParkProjectile timer */
+	FTimerHandle TimerHandle_ParkProjectile;
+
 	/** update velocity on client */
 	virtual void PostNetReceiveVelocity(const FVector& NewVelocity) override;
 
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterProjectileMover.generated.h"
+
+class AShooterProjectile;
+
+//
+// Moves every flying projectile of the world in one tick.
+// Projectiles and their movement components don't register tick functions, a projectile is added here while it flies
+// and its movement component is stepped directly, so parked and in-flight projectiles cost no tick function dispatch.
+//
+UCLASS()
+class UShooterProjectileMover : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	/** start moving projectile every frame */
+	void RegisterProjectile(AShooterProjectile* Projectile);
+
+	/** stop moving projectile, safe to call while moving */
+	void UnregisterProjectile(AShooterProjectile* Projectile);
+
+	/** print mover state to the log */
+	void DumpStats() const;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+private:
+
+	/** moved projectiles, null slots are removed after the move */
+	TArray<TWeakObjectPtr<AShooterProjectile>> Projectiles;
+
+	/** number of non null slots */
+	int32 NumProjectiles;
+};
@@ -4,6 +4,8 @@
 
 #include "GameFramework/Actor.h"
 #include "Engine/Canvas.h" // for FCanvasIcon
+#include "ShooterWeaponFXPool.h"
+#include "ShooterWeaponStats.h"
 #include "ShooterWeapon.generated.h"
 
 class UAnimMontage;
@@ -25,52 +27,6 @@ namespace EWeaponState
 	};
 }
 
-USTRUCT()
-struct FWeaponData
-{
-	GENERATED_USTRUCT_BODY()
-
-	/** inifite ammo for reloads */
-	UPROPERTY(EditDefaultsOnly, Category=Ammo)
-	bool bInfiniteAmmo;
-
-	/** infinite ammo in clip, no reload required */
-	UPROPERTY(EditDefaultsOnly, Category=Ammo)
-	bool bInfiniteClip;
-
-	/** max ammo */
-	UPROPERTY(EditDefaultsOnly, Category=Ammo)
-	int32 MaxAmmo;
-
-	/** clip size */
-	UPROPERTY(EditDefaultsOnly, Category=Ammo)
-	int32 AmmoPerClip;
-
-	/** initial clips */
-	UPROPERTY(EditDefaultsOnly, Category=Ammo)
-	int32 InitialClips;
-
-	/** time between two consecutive shots */
-	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
-	float TimeBetweenShots;
-
-	/** failsafe reload duration if weapon doesn't have any animation for it */
-	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
-	float NoAnimReloadDuration;
-
-	/** defaults */
-	FWeaponData()
-	{
-		bInfiniteAmmo = false;
-		bInfiniteClip = false;
-		MaxAmmo = 100;
-		AmmoPerClip = 20;
-		InitialClips = 4;
-		TimeBetweenShots = 0.2f;
-		NoAnimReloadDuration = 1.0f;
-	}
-};
-
 USTRUCT()
 struct FWeaponAnim
 {
@@ -101,6 +57,13 @@ class AShooterWeapon : public AActor
 
 	virtual void Destroyed() override;
 
+	/** count weapons that tick, native weapons never do but blueprints with a tick event still can */
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** look up this weapon's row in the weapon stats table again */
+	void RefreshStats();
+
 	//////////////////////////////////////////////////////////////////////////
 	// Ammo
 	
@@ -131,6 +94,15 @@ class AShooterWeapon : public AActor
 
 	void SetAmmoInClip(int32 Ammo);
 
+	/** [server] refill to the initial clips, used when the weapon is kept for another life */
+	void ResetAmmo();
+
+	/** Damage type dealt by this weapon, nullptr if it doesn't deal damage itself.*/
+	virtual TSubclassOf<UDamageType> GetDamageType() const
+	{
+		return nullptr;
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 	// Inventory
 
@@ -266,11 +238,7 @@ class AShooterWeapon : public AActor
 	UPROPERTY(EditDefaultsOnly, Category=HUD)
 	bool bHideCrosshairWhileNotAiming;
 
-	/** Adjustment to handle frame rate affecting actual timer interval. */
-	UPROPERTY(Transient)
-	float TimerIntervalAdjustment;
-
-	/** Whether to allow automatic weapons to catch up with shorter refire cycles */
+	/** Whether to allow automatic weapons to fire every shot that came due during a frame, instead of one per frame */
 	UPROPERTY(Config)
 	bool bAllowAutomaticWeaponCatchup = true;
 
@@ -295,10 +263,35 @@ protected:
 	UPROPERTY(Transient, ReplicatedUsing=OnRep_MyPawn)
 	class AShooterCharacter* MyPawn;
 
-	/** weapon data */
+	/** weapon data, used when the weapon stats table has no row for StatsId */
 	UPROPERTY(EditDefaultsOnly, Category=Config)
 	FWeaponData WeaponConfig;
 
+	/** row of the weapon stats table holding this weapon's stats */
+	UPROPERTY(EditDefaultsOnly, Category=Config)
+	FName StatsId;
+
+	/** weapon stats table of the world */
+	UPROPERTY(Transient)
+	UShooterWeaponStats* StatsTable;
+
+	/** index of StatsId in the stats table, INDEX_NONE to use the config set on the weapon */
+	int32 StatsIndex;
+
+	/** stats of one kind from the stats table, Defaults if the weapon has no row */
+	template<typename TData>
+	const TData& GetStats(const TData& Defaults) const
+	{
+		const TData* Row = StatsTable ? StatsTable->FindStats<TData>(StatsIndex) : nullptr;
+		return Row ? *Row : Defaults;
+	}
+
+	/** ammo and fire rate stats */
+	const FWeaponData& GetWeaponStats() const
+	{
+		return GetStats(WeaponConfig);
+	}
+
 private:
 	/** weapon mesh: 1st person view */
 	UPROPERTY(VisibleDefaultsOnly, Category=Mesh)
@@ -329,6 +322,10 @@ protected:
 	UPROPERTY(Transient)
 	UParticleSystemComponent* MuzzlePSCSecondary;
 
+	/** muzzle FX components reused for every shot */
+	UPROPERTY(Transient)
+	FShooterWeaponFXPool MuzzleFXPool;
+
 	/** camera shake on firing */
 	UPROPERTY(EditDefaultsOnly, Category=Effects)
 	TSubclassOf<UMatineeCameraShake> FireCameraShake;
@@ -410,6 +407,12 @@ protected:
 	/** time of last successful weapon fire */
 	float LastFireTime;
 
+	/** [local] time the next automatic shot is due, may be earlier than the current frame */
+	float NextShotTime;
+
+	/** [local] time the shot being fired was due */
+	float CurrentShotTime;
+
 	/** last time when this weapon was switched to */
 	float EquipStartedTime;
 
@@ -485,12 +488,18 @@ protected:
 	UFUNCTION(reliable, server, WithValidation)
 	void ServerHandleFiring();
 
-	/** [local + server] handle weapon refire, compensating for slack time if the timer can't sample fast enough */
+	/** [local + server] handle weapon refire, firing every shot that came due since the last frame */
 	void HandleReFiring();
 
 	/** [local + server] handle weapon fire */
 	void HandleFiring();
 
+	/** [local + server] handle weapon fire of a shot due at ShotTime, at most one frame ago */
+	void HandleFiringAt(float ShotTime);
+
+	/** [local] how long ago the shot being fired was due, 0 unless catching up within a frame */
+	float GetShotAge() const;
+
 	/** [local + server] firing started */
 	virtual void OnBurstStarted();
 
@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "ShooterWeaponFXPool.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+
+/** particle components of one weapon, reused for every shot instead of spawning a new emitter */
+USTRUCT()
+struct FShooterWeaponFXPool
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** components owned by the weapon */
+	UPROPERTY(Transient)
+	TArray<UParticleSystemComponent*> Components;
+
+	/** max number of components, the oldest one is restarted once all are busy */
+	int32 MaxComponents;
+
+	/** next component to restart when all are busy */
+	int32 NextToRecycle;
+
+	FShooterWeaponFXPool()
+		: MaxComponents(4)
+		, NextToRecycle(0)
+	{
+	}
+
+	explicit FShooterWeaponFXPool(int32 InMaxComponents)
+		: MaxComponents(InMaxComponents)
+		, NextToRecycle(0)
+	{
+	}
+
+	/** get a component set up for the template, attached to AttachTo or free in the world if null. Caller activates it. */
+	UParticleSystemComponent* Acquire(AActor* Owner, UParticleSystem* Template, USceneComponent* AttachTo = nullptr, FName SocketName = NAME_None);
+
+	/** number of components created so far */
+	int32 Num() const { return Components.Num(); }
+
+private:
+
+	/** is component done playing? */
+	static bool IsFree(UParticleSystemComponent* PSC);
+};
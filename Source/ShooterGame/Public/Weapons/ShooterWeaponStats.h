@@ -0,0 +1,272 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DataTable.h"
+#include "GameFramework/DamageType.h" // for UDamageType::StaticClass()
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterWeaponStats.generated.h"
+
+USTRUCT()
+struct FWeaponData
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** inifite ammo for reloads */
+	UPROPERTY(EditDefaultsOnly, Category=Ammo)
+	bool bInfiniteAmmo;
+
+	/** infinite ammo in clip, no reload required */
+	UPROPERTY(EditDefaultsOnly, Category=Ammo)
+	bool bInfiniteClip;
+
+	/** max ammo */
+	UPROPERTY(EditDefaultsOnly, Category=Ammo)
+	int32 MaxAmmo;
+
+	/** clip size */
+	UPROPERTY(EditDefaultsOnly, Category=Ammo)
+	int32 AmmoPerClip;
+
+	/** initial clips */
+	UPROPERTY(EditDefaultsOnly, Category=Ammo)
+	int32 InitialClips;
+
+	/** time between two consecutive shots */
+	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
+	float TimeBetweenShots;
+
+	/** failsafe reload duration if weapon doesn't have any animation for it */
+	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
+	float NoAnimReloadDuration;
+
+	/** defaults */
+	FWeaponData()
+	{
+		bInfiniteAmmo = false;
+		bInfiniteClip = false;
+		MaxAmmo = 100;
+		AmmoPerClip = 20;
+		InitialClips = 4;
+		TimeBetweenShots = 0.2f;
+		NoAnimReloadDuration = 1.0f;
+	}
+};
+
+USTRUCT()
+struct FInstantWeaponData
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** base weapon spread (degrees) */
+	UPROPERTY(EditDefaultsOnly, Category=Accuracy)
+	float WeaponSpread;
+
+	/** targeting spread modifier */
+	UPROPERTY(EditDefaultsOnly, Category=Accuracy)
+	float TargetingSpreadMod;
+
+	/** continuous firing: spread increment */
+	UPROPERTY(EditDefaultsOnly, Category=Accuracy)
+	float FiringSpreadIncrement;
+
+	/** continuous firing: max increment */
+	UPROPERTY(EditDefaultsOnly, Category=Accuracy)
+	float FiringSpreadMax;
+
+	/** weapon range */
+	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
+	float WeaponRange;
+
+	/** damage amount, per pellet */
+	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
+	int32 HitDamage;
+
+	/** pellets fired per shot, more than one for shotgun style weapons (max 16) */
+	UPROPERTY(EditDefaultsOnly, Category=WeaponStat, meta=(ClampMin=1, ClampMax=16))
+	int32 PelletCount;
+
+	/** type of damage */
+	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
+	TSubclassOf<UDamageType> DamageType;
+
+	/** hit verification: scale for bounding box of hit actor */
+	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
+	float ClientSideHitLeeway;
+
+	/** hit verification: threshold for dot product between view direction and hit direction */
+	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
+	float AllowedViewDotHitDir;
+
+	/** hit verification: distance added around a pawn's rewound hitbox, covers limbs outside of the capsule */
+	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
+	float LagCompensationLeeway;
+
+	/** defaults */
+	FInstantWeaponData()
+	{
+		WeaponSpread = 5.0f;
+		TargetingSpreadMod = 0.25f;
+		FiringSpreadIncrement = 1.0f;
+		FiringSpreadMax = 10.0f;
+		WeaponRange = 10000.0f;
+		HitDamage = 10;
+		PelletCount = 1;
+		DamageType = UDamageType::StaticClass();
+		ClientSideHitLeeway = 200.0f;
+		AllowedViewDotHitDir = 0.8f;
+		LagCompensationLeeway = 40.0f;
+	}
+};
+
+USTRUCT()
+struct FProjectileWeaponData
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** projectile class */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile)
+	TSubclassOf<class AShooterProjectile> ProjectileClass;
+
+	/** life time */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile)
+	float ProjectileLife;
+
+	/** damage at impact point */
+	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
+	int32 ExplosionDamage;
+
+	/** radius of damage */
+	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
+	float ExplosionRadius;
+
+	/** type of damage */
+	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
+	TSubclassOf<UDamageType> DamageType;
+
+	/** defaults */
+	FProjectileWeaponData()
+	{
+		ProjectileClass = NULL;
+		ProjectileLife = 10.0f;
+		ExplosionDamage = 100;
+		ExplosionRadius = 300.0f;
+		DamageType = UDamageType::StaticClass();
+	}
+};
+
+/** stats of one weapon in the weapon stats table, the row name is the weapon's StatsId */
+USTRUCT(BlueprintType)
+struct FShooterWeaponStatsRow : public FTableRowBase
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** ammo and fire rate */
+	UPROPERTY(EditAnywhere, Category=Weapon)
+	FWeaponData Weapon;
+
+	/** used by instant hit weapons */
+	UPROPERTY(EditAnywhere, Category=Weapon)
+	FInstantWeaponData Instant;
+
+	/** used by projectile weapons */
+	UPROPERTY(EditAnywhere, Category=Weapon)
+	FProjectileWeaponData Projectile;
+};
+
+//
+// Read-only weapon stats of every weapon in the stats table. There are three columns indexed by weapon, one array each
+// of FWeaponData, FInstantWeaponData and FProjectileWeaponData, not one array per field.
+// Weapons look up their row once and read their stats from here instead of from their own config,
+// so a balance pass only needs the table reloaded (ShooterGame.ReloadWeaponStats), not the server restarted.
+// The server sends reloaded stats to its clients, and a reloaded file is loaded again by the next map.
+// Weapons without a row keep using the config set on their blueprint. No table is configured yet, so until
+// WeaponStatsTable is set in DefaultGame.ini (see the commented entry there) all weapons use their blueprint config.
+//
+UCLASS(Config=Game)
+class UShooterWeaponStats : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** index of a weapon's row, INDEX_NONE if the table doesn't have it */
+	int32 FindWeaponIndex(FName WeaponId) const;
+
+	/** stats of one kind for a weapon index, null for INDEX_NONE */
+	template<typename TData>
+	const TData* FindStats(int32 WeaponIndex) const;
+
+	/** read the configured table again, or the given csv / json file, and point weapons at the new rows. The server sends the new rows to its clients. */
+	bool Reload(const FString& FilePath);
+
+	/** [server] send a joining player the stats reloaded since the map started, nothing if the configured table is in use */
+	void SendReloadedStats(class AShooterPlayerController* PC) const;
+
+	/** [client] take the rows sent by the server */
+	void ReceiveStats(const TArray<FName>& RowNames, const TArray<FShooterWeaponStatsRow>& Rows);
+
+	/** print the table to the log */
+	void DumpStats() const;
+
+private:
+
+	/** copy rows into the columns, rows already loaded keep their index */
+	void LoadRows(const UDataTable* Table);
+
+	/** copy one row into the columns */
+	void SetRow(FName RowName, const FShooterWeaponStatsRow& Row);
+
+	/** read rows from a csv / json file */
+	bool LoadFile(const FString& FilePath);
+
+	/** point weapons in the world at the current rows */
+	void RefreshWeapons();
+
+	/** send all rows to a client */
+	void SendStats(class AShooterPlayerController* PC) const;
+
+	/** table loaded on startup, none by default */
+	UPROPERTY(Config)
+	TSoftObjectPtr<UDataTable> WeaponStatsTable;
+
+	/** stats were reloaded after the configured table, joining clients need them sent */
+	bool bStatsReloaded;
+
+	/** weapon index by row name */
+	TMap<FName, int32> WeaponIndices;
+
+	/** row names by weapon index */
+	TArray<FName> WeaponIds;
+
+	UPROPERTY(Transient)
+	TArray<FWeaponData> WeaponStats;
+
+	UPROPERTY(Transient)
+	TArray<FInstantWeaponData> InstantStats;
+
+	UPROPERTY(Transient)
+	TArray<FProjectileWeaponData> ProjectileStats;
+};
+
+template<>
+inline const FWeaponData* UShooterWeaponStats::FindStats<FWeaponData>(int32 WeaponIndex) const
+{
+	return WeaponStats.IsValidIndex(WeaponIndex) ? &WeaponStats[WeaponIndex] : nullptr;
+}
+
+template<>
+inline const FInstantWeaponData* UShooterWeaponStats::FindStats<FInstantWeaponData>(int32 WeaponIndex) const
+{
+	return InstantStats.IsValidIndex(WeaponIndex) ? &InstantStats[WeaponIndex] : nullptr;
+}
+
+template<>
+inline const FProjectileWeaponData* UShooterWeaponStats::FindStats<FProjectileWeaponData>(int32 WeaponIndex) const
+{
+	return ProjectileStats.IsValidIndex(WeaponIndex) ? &ProjectileStats[WeaponIndex] : nullptr;
+}
@@ -3,10 +3,14 @@
 #pragma once
 
 #include "ShooterWeapon.h"
+#include "ShooterHitRejectionTelemetry.h"
 #include "ShooterWeapon_Instant.generated.h"
 
 class AShooterImpactEffect;
+struct FTraceHandle;
+struct FTraceDatum;
 
+/** shot replicated to remote clients, either as the resolved impact or as the shot parameters to trace again */
 USTRUCT()
 struct FInstantHitInfo
 {
@@ -21,68 +25,166 @@ struct FInstantHitInfo
 	UPROPERTY()
 	int32 RandomSeed;
 
+	/** end of the trail, impact point for blocking hits, 0.1 unit precision */
+	FVector EndPoint;
+
+	/** impact normal, octahedron encoded on the wire */
+	FVector ImpactNormal;
+
+	/** EPhysicalSurface of the impact */
+	uint8 SurfaceType;
+
+	/** did the shot hit something? */
+	uint8 bImpact : 1;
+
+	/** carries the resolved impact instead of Origin / RandomSeed / ReticleSpread */
+	uint8 bImpactRecord : 1;
+
+	/** pellets fired from RandomSeed, never sent as an impact record when more than one */
+	uint8 NumPellets;
+
 	FInstantHitInfo()
 		: Origin(0)
 		, ReticleSpread(0)
 		, RandomSeed(0)
+		, EndPoint(0)
+		, ImpactNormal(0)
+		, SurfaceType(0)
+		, bImpact(false)
+		, bImpactRecord(false)
+		, NumPellets(1)
 	{
 	}
+
+	/** pack unit vector into 2x10 bits */
+	static uint32 EncodeNormal(const FVector& Normal);
+
+	/** unpack unit vector from EncodeNormal */
+	static FVector DecodeNormal(uint32 Packed);
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FInstantHitInfo& Other) const;
 };
 
+template<>
+struct TStructOpsTypeTraits<FInstantHitInfo> : public TStructOpsTypeTraitsBase2<FInstantHitInfo>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+/** pellets of one shot waiting for their async traces */
+struct FShooterPelletVolley
+{
+	/** max pellets of a shot */
+	static const int32 MaxPellets = 16;
+
+	/** id of the volley in the trace user data */
+	uint32 Id;
+
+	/** start of every pellet's trace */
+	FVector Origin;
+
+	FVector ShootDirs[MaxPellets];
+
+	FHitResult Impacts[MaxPellets];
+
+	int32 RandomSeed;
+
+	float ReticleSpread;
+
+	/** time the shot was due */
+	float ShotTime;
+
+	int32 NumPellets;
+
+	/** traces not back yet */
+	int32 NumPending;
+
+	/** replicated from the server, only plays effects */
+	bool bSimulated;
+};
+
+/** damage collected from the pellets / shots of one batch, dealt once per victim */
+struct FShooterPendingDamage
+{
+	TWeakObjectPtr<AActor> Victim;
+
+	/** first hit on the victim */
+	FHitResult Impact;
+
+	FVector ShootDir;
+
+	float Damage;
+};
+
+/** client shot reported to the server in a batch, quantized for the wire */
 USTRUCT()
-struct FInstantWeaponData
+struct FShooterShotRecord
 {
 	GENERATED_USTRUCT_BODY()
 
-	/** base weapon spread (degrees) */
-	UPROPERTY(EditDefaultsOnly, Category=Accuracy)
-	float WeaponSpread;
+	/** actor hit, null for misses and world geometry */
+	UPROPERTY()
+	AActor* HitActor;
 
-	/** targeting spread modifier */
-	UPROPERTY(EditDefaultsOnly, Category=Accuracy)
-	float TargetingSpreadMod;
+	/** impact point, 0.1 unit precision, only sent for blocking hits */
+	FVector ImpactPoint;
 
-	/** continuous firing: spread increment */
-	UPROPERTY(EditDefaultsOnly, Category=Accuracy)
-	float FiringSpreadIncrement;
+	/** impact normal, only sent for blocking hits */
+	FVector ImpactNormal;
 
-	/** continuous firing: max increment */
-	UPROPERTY(EditDefaultsOnly, Category=Accuracy)
-	float FiringSpreadMax;
+	/** direction of the shot */
+	FVector ShootDir;
 
-	/** weapon range */
-	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
-	float WeaponRange;
+	/** bone hit on the actor's skeletal mesh, INDEX_NONE if none */
+	int32 BoneIndex;
 
-	/** damage amount */
-	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
-	int32 HitDamage;
+	/** seed of the spread cone */
+	int32 RandomSeed;
 
-	/** type of damage */
-	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
-	TSubclassOf<UDamageType> DamageType;
+	/** spread when fired in degrees, 0.01 degree precision */
+	float ReticleSpread;
 
-	/** hit verification: scale for bounding box of hit actor */
-	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
-	float ClientSideHitLeeway;
+	/** how long before the batch's fire time the shot was due, 1 ms precision */
+	float FireTimeOffset;
 
-	/** hit verification: threshold for dot product between view direction and hit direction */
-	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
-	float AllowedViewDotHitDir;
+	/** did the trace hit something? */
+	uint8 bBlockingHit : 1;
 
-	/** defaults */
-	FInstantWeaponData()
+	FShooterShotRecord()
+		: HitActor(nullptr)
+		, ImpactPoint(ForceInitToZero)
+		, ImpactNormal(ForceInitToZero)
+		, ShootDir(ForceInitToZero)
+		, BoneIndex(INDEX_NONE)
+		, RandomSeed(0)
+		, ReticleSpread(0.0f)
+		, FireTimeOffset(0.0f)
+		, bBlockingHit(false)
 	{
-		WeaponSpread = 5.0f;
-		TargetingSpreadMod = 0.25f;
-		FiringSpreadIncrement = 1.0f;
-		FiringSpreadMax = 10.0f;
-		WeaponRange = 10000.0f;
-		HitDamage = 10;
-		DamageType = UDamageType::StaticClass();
-		ClientSideHitLeeway = 200.0f;
-		AllowedViewDotHitDir = 0.8f;
 	}
+
+	/** record a local trace result */
+	FShooterShotRecord(const FHitResult& Impact, const FVector& InShootDir, int32 InRandomSeed, float InReticleSpread, float InFireTimeOffset = 0.0f);
+
+	/** rebuild the hit result on the server */
+	FHitResult ToHitResult(const FVector& Origin) const;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FShooterShotRecord> : public TStructOpsTypeTraitsBase2<FShooterShotRecord>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
 };
 
 // A weapon where the damage impact occurs instantly upon firing
@@ -94,6 +196,17 @@ class AShooterWeapon_Instant : public AShooterWeapon
 	/** get current spread */
 	float GetCurrentSpread() const;
 
+	/** [local] send the shots of the burst before the server stops firing */
+	virtual void StopFire() override;
+
+	/** [local] shots fired but not sent to the server yet, pellets still being traced included */
+	int32 GetNumUnsentShots() const;
+
+	virtual TSubclassOf<UDamageType> GetDamageType() const override
+	{
+		return GetInstantStats().DamageType;
+	}
+
 protected:
 
 	virtual EAmmoType GetAmmoType() const override
@@ -101,10 +214,16 @@ protected:
 		return EAmmoType::EBullet;
 	}
 
-	/** weapon config */
+	/** weapon config, used when the weapon stats table has no row for StatsId */
 	UPROPERTY(EditDefaultsOnly, Category=Config)
 	FInstantWeaponData InstantConfig;
 
+	/** instant hit stats */
+	const FInstantWeaponData& GetInstantStats() const
+	{
+		return GetStats(InstantConfig);
+	}
+
 	/** impact effects */
 	UPROPERTY(EditDefaultsOnly, Category=Effects)
 	TSubclassOf<AShooterImpactEffect> ImpactTemplate;
@@ -124,16 +243,65 @@ protected:
 	/** current spread from continuous firing */
 	float CurrentFiringSpread;
 
+	/** max shots reported to the server in one batch */
+	static const int32 MaxShotsPerBatch = 64;
+
+	/** trail FX components reused for every shot */
+	UPROPERTY(Transient)
+	FShooterWeaponFXPool TrailFXPool;
+
+	/** [local] shots fired this frame, sent to the server in one batch */
+	UPROPERTY(Transient)
+	TArray<FShooterShotRecord> PendingShots;
+
+	/** [local] server time of the frame the pending shots were fired in */
+	float PendingShotsFireTime;
+
+	/** Handle for efficient management of FlushPendingShots timer */
+	FTimerHandle TimerHandle_FlushPendingShots;
+
+	/** multi pellet shots waiting for their traces */
+	TArray<FShooterPelletVolley> PendingVolleys;
+
+	/** id of the next volley */
+	uint32 NextVolleyId;
+
+	/** damage of the open damage batch */
+	TArray<FShooterPendingDamage, TInlineAllocator<4>> PendingDamage;
+
+	/** nesting of BeginDamageBatch */
+	int32 DamageBatchDepth;
+
 	//////////////////////////////////////////////////////////////////////////
 	// Weapon usage
 
-	/** server notified of hit from client to verify */
+	/** server notified of the hits and misses of one client frame to verify */
 	UFUNCTION(reliable, server, WithValidation)
-	void ServerNotifyHit(const FHitResult& Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread);
+	void ServerNotifyShots(const TArray<FShooterShotRecord>& Shots, float ClientFireTime);
+
+	/** [local] add shot to the batch sent at the end of the frame */
+	void QueueShotForServer(const FHitResult& Impact, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
+
+	/** [local] send pending shots to the server */
+	void FlushPendingShots();
+
+	/** [server] verify a client hit and apply it */
+	void ServerVerifyHit(const FHitResult& Impact, const FVector& Origin, const FVector& ViewDir, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread, float ClientFireTime);
 
-	/** server notified of miss to show trail FX */
-	UFUNCTION(unreliable, server, WithValidation)
-	void ServerNotifyMiss(FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread);
+	/** [server] replicate shot to remote clients */
+	void SetHitNotify(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
+
+	/** [server] play trail FX of a client miss */
+	void ServerProcessMiss(const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
+
+	/** [server] accept a client hit on a moving actor if it's within its inflated bounding box */
+	void ValidateHitAgainstBounds(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
+
+	/** [server] count a rejected client hit in the telemetry of its connection */
+	void RejectHit(EShooterHitRejection Reason, float DistanceError, float AngleError);
+
+	/** distance from a location to a box, 0 inside */
+	static float GetBoxError(const FVector& Location, const FVector& BoxCenter, const FVector& BoxExtent);
 
 	/** process the instant hit and notify the server if necessary */
 	void ProcessInstantHit(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
@@ -144,9 +312,36 @@ protected:
 	/** check if weapon should deal damage to actor */
 	bool ShouldDealDamage(AActor* TestActor) const;
 
-	/** handle damage */
+	/** handle damage, added to the victim's pending damage while a damage batch is open */
 	void DealDamage(const FHitResult& Impact, const FVector& ShootDir);
 
+	/** apply damage to the hit actor */
+	void ApplyPointDamage(const FHitResult& Impact, const FVector& ShootDir, float Damage);
+
+	/** collect damage per victim until FlushDamageBatch */
+	void BeginDamageBatch();
+
+	/** deal the damage collected since BeginDamageBatch, one event per victim */
+	void FlushDamageBatch();
+
+	/** [local] fire every pellet of a shot, processed once all traces are back */
+	void FirePellets(const FVector& Origin, const FVector& AimDir, int32 RandomSeed, float ReticleSpread, int32 NumPellets);
+
+	/** pellet directions of a shot, same for every machine given the seed */
+	static void GetPelletDirections(const FVector& AimDir, float ConeHalfAngle, int32 RandomSeed, int32 NumPellets, FVector* OutDirs);
+
+	/** start the async trace of every pellet */
+	void TraceVolley(FShooterPelletVolley& Volley);
+
+	/** pellet trace came back */
+	void OnPelletTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceData);
+
+	/** [local] trace the pellets of fired volleys right away instead of waiting for the async traces */
+	void FinishPendingVolleys();
+
+	/** process the hits of a volley, or play its effects for a simulated one */
+	void ProcessVolley(const FShooterPelletVolley& Volley);
+
 	/** [local] weapon specific fire implementation */
 	virtual void FireWeapon() override;
 
@@ -163,8 +358,14 @@ protected:
 	/** called in network play to do the cosmetic fx  */
 	void SimulateInstantHit(const FVector& Origin, int32 RandomSeed, float ReticleSpread);
 
-	/** spawn effects for impact */
-	void SpawnImpactEffects(const FHitResult& Impact);
+	/** cosmetic fx of a multi pellet shot, traced again like the single shot */
+	void SimulatePellets(const FVector& Origin, int32 RandomSeed, float ReticleSpread, int32 NumPellets);
+
+	/** play the cosmetic fx of a replicated impact record, without tracing */
+	void SimulateImpactRecord(const FInstantHitInfo& HitInfo);
+
+	/** spawn effects for impact, SurfaceType_Max takes the surface from the hit's physical material */
+	void SpawnImpactEffects(const FHitResult& Impact, EPhysicalSurface SurfaceType = SurfaceType_Max);
 
 	/** spawn trail effect */
 	void SpawnTrailEffect(const FVector& EndPoint);
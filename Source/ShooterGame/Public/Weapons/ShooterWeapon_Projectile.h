@@ -3,45 +3,8 @@
 #pragma once
 
 #include "ShooterWeapon.h"
-#include "GameFramework/DamageType.h" // for UDamageType::StaticClass()
 #include "ShooterWeapon_Projectile.generated.h"
 
-USTRUCT()
-struct FProjectileWeaponData
-{
-	GENERATED_USTRUCT_BODY()
-
-	/** projectile class */
-	UPROPERTY(EditDefaultsOnly, Category=Projectile)
-	TSubclassOf<class AShooterProjectile> ProjectileClass;
-
-	/** life time */
-	UPROPERTY(EditDefaultsOnly, Category=Projectile)
-	float ProjectileLife;
-
-	/** damage at impact point */
-	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
-	int32 ExplosionDamage;
-
-	/** radius of damage */
-	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
-	float ExplosionRadius;
-
-	/** type of damage */
-	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
-	TSubclassOf<UDamageType> DamageType;
-
-	/** defaults */
-	FProjectileWeaponData()
-	{
-		ProjectileClass = NULL;
-		ProjectileLife = 10.0f;
-		ExplosionDamage = 100;
-		ExplosionRadius = 300.0f;
-		DamageType = UDamageType::StaticClass();
-	}
-};
-
 // A weapon that fires a visible projectile
 UCLASS(Abstract)
 class AShooterWeapon_Projectile : public AShooterWeapon
@@ -51,6 +14,17 @@ class AShooterWeapon_Projectile : public AShooterWeapon
 	/** apply config on projectile */
 	void ApplyWeaponConfig(FProjectileWeaponData& Data);
 
+	/** [server] take back a projectile that's done flying */
+	void ReturnProjectile(AShooterProjectile* Projectile);
+
+	/** destroy parked projectiles */
+	virtual void Destroyed() override;
+
+	virtual TSubclassOf<UDamageType> GetDamageType() const override
+	{
+		return GetProjectileStats().DamageType;
+	}
+
 protected:
 
 	virtual EAmmoType GetAmmoType() const override
@@ -58,10 +32,16 @@ protected:
 		return EAmmoType::ERocket;
 	}
 
-	/** weapon config */
+	/** weapon config, used when the weapon stats table has no row for StatsId */
 	UPROPERTY(EditDefaultsOnly, Category=Config)
 	FProjectileWeaponData ProjectileConfig;
 
+	/** projectile stats */
+	const FProjectileWeaponData& GetProjectileStats() const
+	{
+		return GetStats(ProjectileConfig);
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 	// Weapon usage
 
@@ -71,4 +51,8 @@ protected:
 	/** spawn projectile on server */
 	UFUNCTION(reliable, server, WithValidation)
 	void ServerFireProjectile(FVector Origin, FVector_NetQuantizeNormal ShootDir);
+
+	/** [server] parked projectiles, attached to this weapon and kept replicating so clients reuse them too */
+	UPROPERTY(Transient)
+	TArray<AShooterProjectile*> ParkedProjectiles;
 };